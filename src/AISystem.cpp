@@ -1,37 +1,34 @@
 #include "AISystem.h"
+#include "./ECS/components/DescriptionComponent.h"
+#include "./ECS/components/InfoBoxComponent.h"
+#include "./ECS/MovementManager.h"
+#include <algorithm>
 #include <iostream>
 
-// Update the constructor to accept the new manager
-AISystem::AISystem(AIManager *aiManager,
-                   PositionManager *posManager,
-                   MovementManager *moveManager,
-                   DescriptionComponentManager *descManager,
+AISystem::AISystem(ECS::World *world,
                    Pathfinder *pathfinder,
                    Grid *grid,
                    GeminiClient *gemini,
-                   InfoBoxManager *infoBoxManager,
                    Clock *clock,
-                   HomeManager *homeManager, // Add parameter
-                   Uint32 cellSize)
-    : aiManager(aiManager),
-      posManager(posManager),
-      moveManager(moveManager),
-      descManager(descManager),
+                   HomeManager *homeManager,
+                   unsigned int cellSize)
+    : world(world),
       pathfinder(pathfinder),
       grid(grid),
       gemini(gemini),
-      infoBoxManager(infoBoxManager),
       clock(clock),
-      homeManager(homeManager), // Initialize member
+      homeManager(homeManager),
       cellSize(cellSize)
 {
+    world->events().subscribe<MovementPhaseChanged>(
+        [this](std::span<const MovementPhaseChanged> events) { onMovementPhaseChanged(events); });
 }
 
 void AISystem::update(float deltaTime)
 {
     updateAI(deltaTime);
-    processArrivingEntities();
-    processPlanningEntities();
+    world->events().dispatch<MovementPhaseChanged>();
+    processPlanningEntities(deltaTime);
 }
 
 void AISystem::updateAI(float deltaTime)
@@ -43,69 +40,84 @@ void AISystem::updateAI(float deltaTime)
     }
     aiUpdateTimer -= aiUpdateInterval;
 
-    for (auto &[uid, aiState] : aiManager->states)
+    for (auto [entity, aiState, movement, position] : world->view<AIState, Movement, PositionComponent>())
     {
-        auto *movement = moveManager->get(uid);
-        auto *position = posManager->get(uid);
-
-        if (!movement || !position)
-            continue;
-
         // Only process AI for entities that are idle or can accept new commands
-        if (movement->phase == MovementPhase::IDLE)
+        if (movement.phase == MovementPhase::IDLE)
         {
-            planNextAction(uid);
+            if (aiState.currentState == AIStateName::PerformingActivity)
+            {
+                world->events().emit(ActivityFinished{entity, false});
+            }
+            planNextAction(entity, aiState, movement);
         }
-        else if (movement->phase == MovementPhase::MOVING &&
+        else if (movement.phase == MovementPhase::MOVING &&
                  aiState.currentState == AIStateName::MovingToZone)
         {
             // Update info during movement
-            auto *infoBox = infoBoxManager->get(uid);
-            auto *description = descManager->get(uid);
-            std::string entityName = description ? description->name : "Unknown";
-
-            if (infoBox)
-            {
-                infoBox->text = entityName + "\nMoving to " + aiState.targetZone;
-            }
+            setInfoText(entity, "Moving to " + aiState.targetZone);
         }
     }
 }
 
-void AISystem::processArrivingEntities()
+void AISystem::syncWithWorld()
 {
-    // Use the existing states map instead of getAllEntities()
-    for (auto &[entityUID, aiState] : aiManager->states)
+    performingEntities.clear();
+    for (auto [entity, aiState] : world->getAllComponents<AIState>())
     {
-        auto *movement = moveManager->get(entityUID);
-        auto *position = posManager->get(entityUID);
-        auto *infoBox = infoBoxManager->get(entityUID);
-        auto *description = descManager->get(entityUID);
+        if (aiState.currentState == AIStateName::PerformingActivity)
+        {
+            performingEntities.push_back(entity);
+        }
+    }
+    // Live runs keep this sorted by ID, so a restored run visits entities in the same order
+    std::sort(performingEntities.begin(), performingEntities.end());
+    performingNeedsDedup = false;
+}
 
-        if (!movement || !position)
+void AISystem::onMovementPhaseChanged(std::span<const MovementPhaseChanged> events)
+{
+    for (const MovementPhaseChanged &event : events)
+    {
+        // Only a return to IDLE ends a movement step or a planning pause
+        if (event.to != MovementPhase::IDLE)
+        {
             continue;
+        }
 
-        std::string entityName = description ? description->name : "Unknown";
+        ECS::EntityID entityUID = event.entity;
+        auto *state = world->getComponent<AIState>(entityUID);
+        auto *move = world->getComponent<Movement>(entityUID);
+        auto *pos = world->getComponent<PositionComponent>(entityUID);
+        if (!state || !move || !pos)
+        {
+            continue;
+        }
+        AIState &aiState = *state;
+        Movement &movement = *move;
+        const PositionComponent &position = *pos;
 
         // Check if entity has completed a movement step and arrived at destination
         if (aiState.currentState == AIStateName::MovingToZone &&
-            movement->phase == MovementPhase::IDLE &&
-            !movement->isMoving)
+            movement.phase == MovementPhase::IDLE &&
+            !movement.isMoving)
         {
 
-            Point currentCell = {(int)(position->x / cellSize), (int)(position->y / cellSize)};
+            Point currentCell = {(int)(position.x / cellSize), (int)(position.y / cellSize)};
 
             // Check if we've reached the target zone
-            if (grid->zones.find(aiState.targetZone) != grid->zones.end())
+            auto zoneIt = grid->zones.find(aiState.targetZone);
+            if (zoneIt != grid->zones.end())
             {
-                const auto &zone = grid->zones.at(aiState.targetZone);
+                const auto &zone = zoneIt->second;
 
                 if (currentCell.x >= zone.x && currentCell.x < zone.x + zone.width &&
                     currentCell.y >= zone.y && currentCell.y < zone.y + zone.height)
                 {
 
                     // Arrived at destination zone!
-                    aiState.currentState = AIStateName::PerformingActivity;
+                    beginActivity(entityUID, aiState);
+                    world->events().emit(ZoneEntered{entityUID, &zoneIt->first});
 
                     // Update display based on intended activity
                     std::string activity = aiState.intendedActivity.empty() ? "Idle" : aiState.intendedActivity;
@@ -120,105 +132,104 @@ void AISystem::processArrivingEntities()
                         activity = "Sleeping";
                     }
 
-                    if (infoBox)
+                    setInfoText(entityUID, activity);
+
+                    if (log)
                     {
-                        infoBox->text = entityName + "\n" + activity;
+                        *log << "NPC " << entityUID << " arrived at " << aiState.targetZone << " and is now " << activity << std::endl;
                     }
-
-                    // Set activity duration
-                    aiState.activityTimer = 300.0f + (rand() % 600); // 5-15 minutes
-
-                    std::cout << "NPC " << entityUID << " arrived at " << aiState.targetZone << " and is now " << activity << std::endl;
                 }
                 else
                 {
                     // Not at destination yet, continue pathfinding
                     // std::cout << "NPC " << entityUID << " completed movement step but hasn't reached " << aiState.targetZone << " yet. Continuing..." << std::endl;
-                    executeMovementPlan(entityUID);
+                    executeMovementPlan(entityUID, aiState, movement, position);
                 }
             }
         }
     }
 }
 
-void AISystem::processPlanningEntities()
+void AISystem::processPlanningEntities(float deltaTime)
 {
-    // Use the existing states map instead of getAllEntities()
-    for (auto &[entityUID, aiState] : aiManager->states)
+    if (performingNeedsDedup)
     {
-        auto *movement = moveManager->get(entityUID);
-        auto *position = posManager->get(entityUID);
-        auto *infoBox = infoBoxManager->get(entityUID);
-        auto *description = descManager->get(entityUID);
-
-        if (!movement || !position)
-            continue;
-
-        std::string entityName = description ? description->name : "Unknown";
+        std::sort(performingEntities.begin(), performingEntities.end());
+        performingEntities.erase(std::unique(performingEntities.begin(), performingEntities.end()),
+                                 performingEntities.end());
+        performingNeedsDedup = false;
+    }
 
-        // Handle entities that are currently performing activities
-        if (aiState.currentState == AIStateName::PerformingActivity)
+    // Handle entities that are currently performing activities, dropping any that stopped
+    size_t kept = 0;
+    for (ECS::EntityID entityUID : performingEntities)
+    {
+        auto *aiState = world->getComponent<AIState>(entityUID);
+        auto *movement = world->getComponent<Movement>(entityUID);
+        if (!aiState || !movement || aiState->currentState != AIStateName::PerformingActivity)
         {
-            // Decrease activity timer
-            aiState.activityTimer -= 16.67f; // Assuming ~60 FPS (16.67ms per frame)
-
-            // Check if it's time to plan next action
-            const auto &timeOfDay = clock->getTimeOfDay();
-            int currentHour = clock->getHour();
+            continue;
+        }
 
-            // During sleep time, keep sleeping if at home
-            if (timeOfDay.isSleepTime(currentHour) &&
-                aiState.targetZone.find("Home") != std::string::npos)
-            {
+        // Decrease activity timer, which counts real milliseconds
+        aiState->activityTimer -= deltaTime * 1000.0f;
 
-                if (infoBox)
-                {
-                    infoBox->text = entityName + "\nSleeping";
-                }
-                continue; // Don't plan new action, keep sleeping
-            }
+        // Check if it's time to plan next action
+        const auto &timeOfDay = clock->getTimeOfDay();
+        int currentHour = clock->getHour();
 
-            // Check if activity timer expired or conditions changed
-            if (aiState.activityTimer <= 0 || shouldReplanActivity(entityUID))
-            {
-                planNextAction(entityUID);
-            }
+        // During sleep time, keep sleeping if at home
+        if (timeOfDay.isSleepTime(currentHour) &&
+            aiState->targetZone.find("Home") != std::string::npos)
+        {
+            setInfoText(entityUID, "Sleeping");
         }
-
-        // Handle planning phase completion -> START MOVEMENT
-        if (aiState.currentState == AIStateName::MovingToZone &&
-            movement->phase == MovementPhase::PLANNING)
+        else if (aiState->activityTimer <= 0 || shouldReplanActivity(*aiState))
         {
+            // Activity timer expired or conditions changed
+            world->events().emit(ActivityFinished{entityUID, aiState->activityTimer <= 0});
+            planNextAction(entityUID, *aiState, *movement);
+        }
 
-            // Check if planning is complete (planning phase timer expired)
-            if (movement->phaseTimer >= movement->planningDuration)
-            {
-                // Execute the movement plan - this is the missing piece!
-                executeMovementPlan(entityUID);
-
-                if (infoBox)
-                {
-                    std::string activity = aiState.intendedActivity.empty() ? "Moving" : "Moving to " + aiState.intendedActivity;
-                    infoBox->text = entityName + "\n" + activity;
-                }
-            }
+        if (aiState->currentState == AIStateName::PerformingActivity)
+        {
+            performingEntities[kept++] = entityUID;
         }
     }
+    performingEntities.resize(kept);
+}
+
+void AISystem::beginActivity(ECS::EntityID entity, AIState &aiState)
+{
+    aiState.currentState = AIStateName::PerformingActivity;
+    aiState.activityTimer = 300.0f + static_cast<float>(random.below(600)); // 5-15 minutes
+
+    // May repeat an entry that processPlanningEntities() has not dropped yet
+    performingEntities.push_back(entity);
+    performingNeedsDedup = true;
 }
 
-void AISystem::planNextAction(unsigned int entityUID)
+void AISystem::publishPhaseChange(ECS::EntityID entity, MovementPhase from, const Movement &movement)
 {
-    auto *aiState = aiManager->get(entityUID);
-    auto *movement = moveManager->get(entityUID);
-    auto *position = posManager->get(entityUID);
-    auto *infoBox = infoBoxManager->get(entityUID);
-    auto *description = descManager->get(entityUID);
+    if (movement.phase == from)
+    {
+        return;
+    }
+    world->events().emit(MovementPhaseChanged{entity, from, movement.phase});
+}
 
-    if (!aiState || !movement || !position)
+void AISystem::setInfoText(ECS::EntityID entity, const std::string &line)
+{
+    auto *infoBox = world->getComponent<InfoBoxComponent>(entity);
+    if (!infoBox)
         return;
 
-    std::string entityName = description ? description->name : "Unknown";
+    auto *description = world->getComponent<DescriptionComponent>(entity);
+    infoBox->text = (description ? description->name : "Unknown") + "\n" + line;
+}
 
+void AISystem::planNextAction(ECS::EntityID entityUID, AIState &aiState, Movement &movement)
+{
     // Choose activities based on time of day
     const auto &timeOfDay = clock->getTimeOfDay();
     int currentHour = clock->getHour();
@@ -261,68 +272,64 @@ void AISystem::planNextAction(unsigned int entityUID)
 
         if (!nonHomeZones.empty())
         {
-            int randomIndex = rand() % nonHomeZones.size();
-            targetZone = nonHomeZones[randomIndex];
+            targetZone = nonHomeZones[random.below(nonHomeZones.size())];
         }
     }
 
     // Store the intended activity for later use
-    aiState->intendedActivity = activity;
+    aiState.intendedActivity = activity;
 
     if (!targetZone.empty() && grid->zones.find(targetZone) != grid->zones.end())
     {
-        aiState->targetZone = targetZone;
-        aiState->currentState = AIStateName::MovingToZone;
+        aiState.targetZone = targetZone;
+        aiState.currentState = AIStateName::MovingToZone;
 
         // Start planning phase before movement
-        movement->startPlanning();
-        // if (infoBox) infoBox->text = entityName + "\nPlanning to " + targetZone;
+        MovementPhase previousPhase = movement.phase;
+        MovementManager::setPhase(*world, entityUID, movement, MovementPhase::PLANNING);
+        publishPhaseChange(entityUID, previousPhase, movement);
     }
     else
     {
         // No valid target zone, just idle
-        if (infoBox)
-            infoBox->text = entityName + "\n" + activity;
+        setInfoText(entityUID, activity);
     }
 }
 
-void AISystem::executeMovementPlan(unsigned int entityUID)
+void AISystem::executeMovementPlan(ECS::EntityID entityUID, AIState &aiState, Movement &movement,
+                                   const PositionComponent &position)
 {
-    auto *aiState = aiManager->get(entityUID);
-    auto *movement = moveManager->get(entityUID);
-    auto *position = posManager->get(entityUID);
-
-    if (!aiState || !movement || !position)
-        return;
-
-    if (aiState->currentState == AIStateName::MovingToZone)
+    if (aiState.currentState == AIStateName::MovingToZone)
     {
-        Point currentCell = {(int)(position->x / cellSize), (int)(position->y / cellSize)};
+        MovementPhase previousPhase = movement.phase;
+        Point currentCell = {(int)(position.x / cellSize), (int)(position.y / cellSize)};
 
         // Check if target zone exists
-        if (grid->zones.find(aiState->targetZone) == grid->zones.end())
+        auto zoneIt = grid->zones.find(aiState.targetZone);
+        if (zoneIt == grid->zones.end())
         {
             // Target zone doesn't exist, go idle
-            aiState->currentState = AIStateName::Idle;
-            movement->phase = MovementPhase::IDLE;
+            aiState.currentState = AIStateName::Idle;
+            MovementManager::setPhase(*world, entityUID, movement, MovementPhase::IDLE);
+            publishPhaseChange(entityUID, previousPhase, movement);
             return;
         }
 
-        const auto &zone = grid->zones.at(aiState->targetZone);
+        const auto &zone = zoneIt->second;
 
         // Check if we're already in the target zone
         if (currentCell.x >= zone.x && currentCell.x < zone.x + zone.width &&
             currentCell.y >= zone.y && currentCell.y < zone.y + zone.height)
         {
             // Already in target zone, transition to performing activity
-            aiState->currentState = AIStateName::PerformingActivity;
-            movement->phase = MovementPhase::IDLE;
-            aiState->activityTimer = 300.0f + (rand() % 600); // 5-15 minutes
+            beginActivity(entityUID, aiState);
+            MovementManager::setPhase(*world, entityUID, movement, MovementPhase::IDLE);
+            publishPhaseChange(entityUID, previousPhase, movement);
             return;
         }
 
         // Find path to the zone and set movement target
-        auto path = pathfinder->findPathToZone(currentCell, aiState->targetZone);
+        auto path = pathfinder->findPathToZone(currentCell, aiState.targetZone);
 
         if (!path.empty() && path.size() > 1)
         {
@@ -332,21 +339,24 @@ void AISystem::executeMovementPlan(unsigned int entityUID)
             float targetY = nextStep.y * cellSize + (cellSize / 2.0f);
 
             // Set the target and start moving
-            movement->setTarget(targetX, targetY);
+            MovementManager::setTarget(*world, entityUID, movement, targetX, targetY);
+            publishPhaseChange(entityUID, previousPhase, movement);
 
-            // CRITICAL FIX: Start the movement phase
-            movement->phase = MovementPhase::MOVING;
-            movement->phaseTimer = 0.0f; // Reset timer
-            movement->isMoving = true;   // Make sure movement flag is set
-
-            std::cout << "NPC " << entityUID << " moving to (" << nextStep.x << ", " << nextStep.y << ") towards " << aiState->targetZone << std::endl;
+            if (log)
+            {
+                *log << "NPC " << entityUID << " moving to (" << nextStep.x << ", " << nextStep.y << ") towards " << aiState.targetZone << std::endl;
+            }
         }
         else
         {
             // No path found, return to idle
-            std::cout << "No path found for NPC " << entityUID << " to " << aiState->targetZone << std::endl;
-            aiState->currentState = AIStateName::Idle;
-            movement->phase = MovementPhase::IDLE;
+            if (log)
+            {
+                *log << "No path found for NPC " << entityUID << " to " << aiState.targetZone << std::endl;
+            }
+            aiState.currentState = AIStateName::Idle;
+            MovementManager::setPhase(*world, entityUID, movement, MovementPhase::IDLE);
+            publishPhaseChange(entityUID, previousPhase, movement);
         }
     }
 }
@@ -402,8 +412,7 @@ std::string AISystem::getRandomLeisureZone()
     // Return random leisure zone, or any non-home zone if none found
     if (!leisureZones.empty())
     {
-        int randomIndex = rand() % leisureZones.size();
-        return leisureZones[randomIndex];
+        return leisureZones[random.below(leisureZones.size())];
     }
     else
     {
@@ -418,8 +427,7 @@ std::string AISystem::getRandomLeisureZone()
         }
         if (!nonHomeZones.empty())
         {
-            int randomIndex = rand() % nonHomeZones.size();
-            return nonHomeZones[randomIndex];
+            return nonHomeZones[random.below(nonHomeZones.size())];
         }
     }
 
@@ -427,27 +435,23 @@ std::string AISystem::getRandomLeisureZone()
 }
 
 // Helper method to determine if we should replan the current activity
-bool AISystem::shouldReplanActivity(unsigned int entityUID)
+bool AISystem::shouldReplanActivity(const AIState &aiState)
 {
-    auto *aiState = aiManager->get(entityUID);
-    if (!aiState)
-        return false;
-
     const auto &timeOfDay = clock->getTimeOfDay();
     int currentHour = clock->getHour();
 
     // Always replan if the time period has changed significantly
-    if (timeOfDay.isSleepTime(currentHour) && aiState->targetZone.find("Home") == std::string::npos)
+    if (timeOfDay.isSleepTime(currentHour) && aiState.targetZone.find("Home") == std::string::npos)
     {
         return true; // Should go home to sleep
     }
 
-    if (timeOfDay.isWorkHours(currentHour) && aiState->targetZone != "Work")
+    if (timeOfDay.isWorkHours(currentHour) && aiState.targetZone != "Work")
     {
         return true; // Should go to work
     }
 
-    if (timeOfDay.isMealTime(currentHour) && aiState->targetZone != "Cafe")
+    if (timeOfDay.isMealTime(currentHour) && aiState.targetZone != "Cafe")
     {
         return true; // Should go eat
     }
@@ -1,59 +1,105 @@
 #pragma once
-#include "./ECS/AIManager.h"
-#include "./ECS/PositionManager.h"
-#include "./ECS/MovementManager.h"
-#include "./ECS/DescriptionComponentManager.h"
+#include "./ECS/World.h"
+#include "./ECS/components/AIState.h"
+#include "./ECS/components/Movement.h"
+#include "./ECS/components/PositionComponent.h"
+#include "./ECS/events/AIEvents.h"
+#include "./ECS/events/MovementEvents.h"
 #include "Pathfinder.h"
 #include "Grid.h"
-#include "GeminiClient.h"
-#include "ECS/InfoBoxManager.h"
 #include "Clock.h"
 #include "TimeOfDay.h"
 #include "HomeManager.h"
+#include "Random.h"
+#include <iostream>
+#include <span>
 
+class GeminiClient; // Optional; not needed for headless runs
 
+
+/**
+ * @brief Drives NPC routines for every entity with AIState, Movement and PositionComponent.
+ *
+ * updateAI() is a joined view over those components every aiUpdateInterval.
+ * The rest is reactive: arrivals and finished planning pauses arrive as
+ * MovementPhaseChanged batches when the world's EventBus is dispatched,
+ * and activity timers only run for the entities currently performing an
+ * activity, so per-frame cost follows how many NPCs changed state rather
+ * than how many exist. ZoneEntered and ActivityFinished are emitted for
+ * other listeners. Optional
+ * InfoBoxComponent and DescriptionComponent data is fetched by array index
+ * only when an entity's text actually changes.
+ */
 class AISystem
 {
 public:
-    AISystem(AIManager *aiManager,
-             PositionManager *posManager,
-             MovementManager *moveManager,
-             DescriptionComponentManager *descManager,
+    AISystem(ECS::World *world,
              Pathfinder *pathfinder,
              Grid *grid,
              GeminiClient *gemini,
-             InfoBoxManager *infoBoxManager,
              Clock *clock,
              HomeManager *homeManager,
-             Uint32 cellSize);
+             unsigned int cellSize);
 
     void update(float deltaTime);
     void updateAI(float deltaTime);
-    void processArrivingEntities();
-    void processPlanningEntities();
+    /**
+     * @brief Counts down the activities in progress by deltaTime real seconds and replans finished ones.
+     */
+    void processPlanningEntities(float deltaTime);
+
+    /**
+     * @brief Rebuilds cached per-entity state after the world was replaced, e.g. by a snapshot load.
+     */
+    void syncWithWorld();
+
+    /**
+     * @brief Restarts the stream that timers and zone choices are drawn from.
+     */
+    void seedRandom(std::uint64_t seed) { random.seed(seed); }
+    Random &getRandom() { return random; }
+    const Random &getRandom() const { return random; }
+
+    /**
+     * @brief Time banked towards the next updateAI() pass; saved with the simulation.
+     */
+    float getUpdateTimer() const { return aiUpdateTimer; }
+    void setUpdateTimer(float seconds) { aiUpdateTimer = seconds; }
+
+    /**
+     * @brief Where arrivals and route choices are reported; null keeps the AI silent.
+     */
+    void setLog(std::ostream *stream) { log = stream; }
 
 private:
-    AIManager *aiManager;
-    PositionManager *posManager;
-    MovementManager *moveManager;
-    DescriptionComponentManager *descManager;
+    ECS::World *world;
     Pathfinder *pathfinder;
     Grid *grid;
     GeminiClient *gemini;
-    InfoBoxManager *infoBoxManager;
     Clock *clock;
     HomeManager *homeManager;
-    Uint32 cellSize;
+    unsigned int cellSize;
     
+    Random random; // Per-simulation stream; never the global rand()
+    std::ostream *log = &std::cout;
+
     // Add timer for AI updates
     float aiUpdateTimer = 0.0f;
     float aiUpdateInterval = 0.5f;
     
+    // Entities that started an activity; stale or repeated entries are dropped by processPlanningEntities()
+    std::vector<ECS::EntityID> performingEntities;
+    bool performingNeedsDedup = false;
+    
     // Helper methods
-    void planNextAction(unsigned int entityUID);
-    void executeMovementPlan(unsigned int entityUID); // Add this declaration
-    void handleArrival(unsigned int entityUID); // Add this declaration too if it's missing
+    void planNextAction(ECS::EntityID entity, AIState &aiState, Movement &movement);
+    void executeMovementPlan(ECS::EntityID entity, AIState &aiState, Movement &movement,
+                             const PositionComponent &position);
+    void onMovementPhaseChanged(std::span<const MovementPhaseChanged> events);
+    void beginActivity(ECS::EntityID entity, AIState &aiState);
+    void publishPhaseChange(ECS::EntityID entity, MovementPhase from, const Movement &movement);
+    void setInfoText(ECS::EntityID entity, const std::string &line);
     std::string getHomeZone(unsigned int npcId);
     std::string getRandomLeisureZone();
-    bool shouldReplanActivity(unsigned int entityUID);
+    bool shouldReplanActivity(const AIState &aiState);
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "BatchRunner.h"
+#include "./ECS/ThreadPool.h"
+#include "./ECS/components/AIState.h"
+#include <algorithm>
+#include <chrono>
+#include <latch>
+#include <limits>
+#include <thread>
+
+BatchRunner::BatchRunner(size_t threadCount)
+    : threadCount(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())) {}
+
+std::vector<BatchRunResult> BatchRunner::run(const std::vector<BatchRunSpec> &specs) const {
+    std::vector<BatchRunResult> results(specs.size());
+    if (specs.empty()) {
+        return results;
+    }
+
+    ECS::ThreadPool pool(std::min(threadCount, specs.size()));
+    std::latch done(static_cast<std::ptrdiff_t>(specs.size()));
+    for (size_t i = 0; i < specs.size(); ++i) {
+        pool.submit([&specs, &results, &done, i]() {
+            results[i] = runOne(specs[i]);
+            done.count_down();
+        });
+    }
+    done.wait();
+    return results;
+}
+
+BatchRunResult BatchRunner::runOne(const BatchRunSpec &spec) {
+    BatchRunResult result;
+    result.seed = spec.config.seed;
+
+    Simulation simulation(spec.config);
+    if (!simulation.loadEnvironment(spec.environmentFile)) {
+        result.error = "failed to load " + spec.environmentFile;
+        return result;
+    }
+    if (!simulation.loadScene(spec.entitiesFile)) {
+        result.error = "failed to load " + spec.entitiesFile;
+        return result;
+    }
+    if (!simulation.spawnAcrossMap("citizen", spec.extraCitizens)) {
+        result.error = spec.entitiesFile + " has no \"citizen\" prefab to spawn from";
+        return result;
+    }
+    simulation.prepareNpcs();
+
+    auto start = std::chrono::steady_clock::now();
+    simulation.runDays(spec.days);
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.ok = true;
+    result.metrics = simulation.getMetrics();
+    result.aiEntities = simulation.getWorld().getAllComponents<AIState>().size();
+    return result;
+}
+
+namespace {
+    struct Summary {
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        double sum = 0.0;
+
+        void add(double value) {
+            min = std::min(min, value);
+            max = std::max(max, value);
+            sum += value;
+        }
+    };
+
+    void writeSummary(std::ostream &out, const char *label, const Summary &summary, size_t count) {
+        out << label << summary.min << " / " << summary.sum / count << " / " << summary.max << "\n";
+    }
+}
+
+void BatchRunner::writeReport(std::ostream &out, const std::vector<BatchRunResult> &results, double batchSeconds,
+                              double soloSeconds) {
+    Summary zones;
+    Summary activities;
+    Summary ticksPerSecond;
+    size_t succeeded = 0;
+
+    out << "seed,ok,ai_entities,ticks,zones_entered,activities_ended,wall_s\n";
+    for (const BatchRunResult &result : results) {
+        out << result.seed << "," << (result.ok ? 1 : 0) << "," << result.aiEntities << ","
+            << result.metrics.ticks << "," << result.metrics.zonesEntered << ","
+            << result.metrics.activitiesFinished << "," << result.wallSeconds;
+        if (!result.ok) {
+            out << ",\"" << result.error << "\"";
+        }
+        out << "\n";
+        if (!result.ok) {
+            continue;
+        }
+        ++succeeded;
+        zones.add(static_cast<double>(result.metrics.zonesEntered));
+        activities.add(static_cast<double>(result.metrics.activitiesFinished));
+        ticksPerSecond.add(result.wallSeconds > 0.0 ? result.metrics.ticks / result.wallSeconds : 0.0);
+    }
+
+    out << "\nRuns:             " << succeeded << "/" << results.size() << " succeeded\n"
+        << "Batch wall time:  " << batchSeconds << " s\n";
+    if (soloSeconds > 0.0 && batchSeconds > 0.0) {
+        double serialSeconds = soloSeconds * static_cast<double>(results.size());
+        out << "Serial estimate:  " << serialSeconds << " s (one run alone x " << results.size() << ")\n"
+            << "Speedup:          " << serialSeconds / batchSeconds << "x over running serially\n";
+    }
+    if (succeeded > 0) {
+        out << "min / mean / max\n";
+        writeSummary(out, "Zones entered:    ", zones, succeeded);
+        writeSummary(out, "Activities ended: ", activities, succeeded);
+        writeSummary(out, "Ticks per second: ", ticksPerSecond, succeeded);
+    }
+    out.flush();
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Simulation.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One run of a batch: what to load and how long to simulate.
+ */
+struct BatchRunSpec {
+    SimulationConfig config;
+    std::string environmentFile = "environment.json";
+    std::string entitiesFile = "entities.json";
+    int days = 1;
+    size_t extraCitizens = 0; // Spawned from the "citizen" prefab
+};
+
+/**
+ * @brief Outcome of one run.
+ */
+struct BatchRunResult {
+    std::uint64_t seed = 0;
+    bool ok = false;
+    std::string error;
+    SimulationMetrics metrics;
+    size_t aiEntities = 0;
+    double wallSeconds = 0.0;
+};
+
+/**
+ * @brief Runs independent simulations in parallel and collects their metrics.
+ *
+ * Each run builds, loads and steps its own Simulation entirely on one pool
+ * worker and writes only its own result slot, and runs finish in whatever
+ * order the cores allow. Results come back in the order of the specs.
+ * The one thing runs can share is SimulationConfig::log, which defaults to
+ * std::cout: leave it null and a run does no console I/O unless one of
+ * its files cannot be read, which Grid and Scene report on std::cerr.
+ */
+class BatchRunner {
+public:
+    /**
+     * @param threadCount Worker threads; 0 uses one per hardware thread.
+     */
+    explicit BatchRunner(size_t threadCount = 0);
+
+    std::vector<BatchRunResult> run(const std::vector<BatchRunSpec> &specs) const;
+
+    /**
+     * @brief Writes one line per run followed by min, mean and max of each metric.
+     *
+     * Runs are timed while they compete for the cores, so their times say
+     * nothing about the serial cost. The speedup line instead compares the
+     * batch against soloSeconds, the wall time of one run measured alone,
+     * times the number of runs; pass 0 to leave it out.
+     */
+    static void writeReport(std::ostream &out, const std::vector<BatchRunResult> &results, double batchSeconds,
+                            double soloSeconds = 0.0);
+
+    size_t getThreadCount() const { return threadCount; }
+
+private:
+    size_t threadCount;
+
+    static BatchRunResult runOne(const BatchRunSpec &spec);
+};
@@ -0,0 +1,118 @@
+#include "Camera.h"
+#include <algorithm>
+#include <cmath>
+
+Camera::Camera(float viewportWidth, float viewportHeight)
+    : viewportWidth(viewportWidth), viewportHeight(viewportHeight)
+{
+}
+
+void Camera::setViewport(float width, float height) {
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+void Camera::setPosition(float worldX, float worldY) {
+    x = worldX;
+    y = worldY;
+}
+
+void Camera::pan(float screenDX, float screenDY) {
+    x += screenDX / zoom;
+    y += screenDY / zoom;
+}
+
+void Camera::zoomAt(float factor, float screenX, float screenY) {
+    SDL_FPoint anchor = screenToWorld(screenX, screenY);
+    zoom = std::clamp(zoom * factor, MIN_ZOOM, MAX_ZOOM);
+
+    // Move the view so the anchor stays under the same screen point
+    x = anchor.x - screenX / zoom;
+    y = anchor.y - screenY / zoom;
+}
+
+void Camera::reset() {
+    x = 0.0f;
+    y = 0.0f;
+    zoom = 1.0f;
+}
+
+SDL_FPoint Camera::worldToScreen(float worldX, float worldY) const {
+    return {(worldX - x) * zoom, (worldY - y) * zoom};
+}
+
+SDL_FPoint Camera::screenToWorld(float screenX, float screenY) const {
+    return {screenX / zoom + x, screenY / zoom + y};
+}
+
+SDL_FRect Camera::getVisibleWorldRect() const {
+    return {x, y, viewportWidth / zoom, viewportHeight / zoom};
+}
+
+void Camera::getVisibleTileRange(int cellSize, int gridWidth, int gridHeight,
+                                 int& minX, int& minY, int& maxX, int& maxY) const {
+    SDL_FRect view = getVisibleWorldRect();
+    minX = std::clamp(static_cast<int>(std::floor(view.x / cellSize)), 0, gridWidth);
+    minY = std::clamp(static_cast<int>(std::floor(view.y / cellSize)), 0, gridHeight);
+    maxX = std::clamp(static_cast<int>(std::ceil((view.x + view.w) / cellSize)), 0, gridWidth);
+    maxY = std::clamp(static_cast<int>(std::ceil((view.y + view.h) / cellSize)), 0, gridHeight);
+}
+
+bool Camera::isVisible(const SDL_FRect& worldRect) const {
+    SDL_FRect view = getVisibleWorldRect();
+    return worldRect.x < view.x + view.w && worldRect.x + worldRect.w > view.x &&
+           worldRect.y < view.y + view.h && worldRect.y + worldRect.h > view.y;
+}
+
+void Camera::beginWorld(SDL_Renderer* renderer) const {
+    SDL_SetRenderScale(renderer, zoom, zoom);
+}
+
+void Camera::endWorld(SDL_Renderer* renderer) const {
+    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+}
+
+bool Camera::handleEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_EVENT_KEY_DOWN:
+            switch (event.key.scancode) {
+                case SDL_SCANCODE_LEFT:  pan(-PAN_STEP, 0); return true;
+                case SDL_SCANCODE_RIGHT: pan(PAN_STEP, 0); return true;
+                case SDL_SCANCODE_UP:    pan(0, -PAN_STEP); return true;
+                case SDL_SCANCODE_DOWN:  pan(0, PAN_STEP); return true;
+                case SDL_SCANCODE_HOME:  reset(); return true;
+                default: return false;
+            }
+
+        case SDL_EVENT_MOUSE_WHEEL:
+            if (event.wheel.y != 0) {
+                zoomAt(event.wheel.y > 0 ? 1.1f : 1.0f / 1.1f, event.wheel.mouse_x, event.wheel.mouse_y);
+                return true;
+            }
+            return false;
+
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            if (event.button.button == SDL_BUTTON_MIDDLE) {
+                dragging = true;
+                return true;
+            }
+            return false;
+
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            if (event.button.button == SDL_BUTTON_MIDDLE) {
+                dragging = false;
+                return true;
+            }
+            return false;
+
+        case SDL_EVENT_MOUSE_MOTION:
+            if (dragging) {
+                pan(-event.motion.xrel, -event.motion.yrel);
+                return true;
+            }
+            return false;
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+/**
+ * @brief 2D camera with pan and zoom over the world.
+ *
+ * World-space drawing (tiles, shapes) is done under the camera's render
+ * scale: callers subtract getX()/getY() from world coordinates between
+ * beginWorld() and endWorld(). Screen-space overlays such as text use
+ * worldToScreen() and are drawn at scale 1 so they stay crisp.
+ */
+class Camera {
+public:
+    Camera(float viewportWidth, float viewportHeight);
+
+    // World position of the top-left corner of the view
+    float getX() const { return x; }
+    float getY() const { return y; }
+    float getZoom() const { return zoom; }
+
+    void setViewport(float width, float height);
+    void setPosition(float worldX, float worldY);
+    void pan(float screenDX, float screenDY);
+
+    /**
+     * @brief Multiplies the zoom level, keeping the given screen point fixed.
+     */
+    void zoomAt(float factor, float screenX, float screenY);
+    void reset();
+
+    SDL_FPoint worldToScreen(float worldX, float worldY) const;
+    SDL_FPoint screenToWorld(float screenX, float screenY) const;
+
+    /**
+     * @brief Rectangle of the world currently covered by the viewport.
+     */
+    SDL_FRect getVisibleWorldRect() const;
+
+    /**
+     * @brief Inclusive-exclusive tile range overlapping the viewport, clamped to the grid.
+     */
+    void getVisibleTileRange(int cellSize, int gridWidth, int gridHeight,
+                             int& minX, int& minY, int& maxX, int& maxY) const;
+
+    /**
+     * @brief Returns true if a world-space rectangle overlaps the viewport.
+     */
+    bool isVisible(const SDL_FRect& worldRect) const;
+
+    void beginWorld(SDL_Renderer* renderer) const;
+    void endWorld(SDL_Renderer* renderer) const;
+
+    /**
+     * @brief Handles pan (arrow keys, middle-drag), zoom (wheel) and reset (Home).
+     * @return true if the event was consumed by the camera.
+     */
+    bool handleEvent(const SDL_Event& event);
+
+private:
+    float x = 0.0f;
+    float y = 0.0f;
+    float zoom = 1.0f;
+    float viewportWidth;
+    float viewportHeight;
+    bool dragging = false;
+
+    static constexpr float MIN_ZOOM = 0.25f;
+    static constexpr float MAX_ZOOM = 4.0f;
+    static constexpr float PAN_STEP = 64.0f;  // Screen pixels per arrow key press
+};
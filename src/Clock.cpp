@@ -40,6 +40,16 @@ void Clock::updateTimeComponents() {
     timeOfDay.updateFromHour(hour);
 }
 
+void Clock::setState(const State& state) {
+    totalSeconds = state.totalSeconds;
+    hour = state.hour;
+    minute = state.minute;
+    day = state.day;
+    timeScale = state.timeScale;
+    paused = state.paused;
+    timeOfDay.updateFromHour(hour);
+}
+
 std::string Clock::getTimeString() const {
     std::stringstream ss;
     ss << "Day " << day << " - " 
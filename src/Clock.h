@@ -28,6 +28,21 @@ public:
     void resume() { paused = false; }
     bool isPaused() const { return paused; }
 
+    /**
+     * @brief Everything needed to resume the clock exactly, for snapshots.
+     */
+    struct State {
+        float totalSeconds;
+        int hour;
+        int minute;
+        int day;
+        float timeScale;
+        bool paused;
+    };
+
+    State getState() const { return { totalSeconds, hour, minute, day, timeScale, paused }; }
+    void setState(const State& state);
+
 private:
     float totalSeconds;  // Total simulation seconds elapsed
     int hour;           // 0-23
@@ -0,0 +1,227 @@
+#include "ArchetypeStorage.h"
+#include <algorithm>
+#include <cassert>
+
+namespace ECS {
+
+    namespace {
+        size_t alignUp(size_t offset, size_t align) {
+            return (offset + align - 1) / align * align;
+        }
+
+        bool signatureLess(const ComponentTypeInfo* a, const ComponentTypeInfo* b) {
+            return a->type < b->type;
+        }
+    }
+
+    Archetype::Archetype(std::vector<const ComponentTypeInfo*> componentTypes)
+        : signature(std::move(componentTypes))
+    {
+        size_t rowBytes = sizeof(EntityID);
+        for (const ComponentTypeInfo* info : signature) {
+            assert(info->align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            rowBytes += info->size;
+        }
+        chunkCapacity = std::max<size_t>(1, CHUNK_BYTES / rowBytes);
+
+        // Entity column first, then one aligned column per component type
+        size_t offset = chunkCapacity * sizeof(EntityID);
+        for (const ComponentTypeInfo* info : signature) {
+            offset = alignUp(offset, info->align);
+            columnOffsets.push_back(offset);
+            offset += chunkCapacity * info->size;
+        }
+        chunkBytes = offset;
+
+        for (size_t columnIndex = 0; columnIndex < signature.size(); ++columnIndex) {
+            ComponentTypeID type = signature[columnIndex]->type;
+            if (type >= columnByType.size()) {
+                columnByType.resize(type + 1, -1);
+            }
+            columnByType[type] = static_cast<int>(columnIndex);
+        }
+    }
+
+    Archetype::~Archetype() {
+        for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+            for (size_t row = 0; row < chunks[chunk].count; ++row) {
+                for (size_t columnIndex = 0; columnIndex < signature.size(); ++columnIndex) {
+                    signature[columnIndex]->destroy(at(chunk, row, columnIndex));
+                }
+            }
+        }
+    }
+
+    void Archetype::setAddEdge(ComponentTypeID type, Archetype* target) {
+        if (type >= addEdges.size()) {
+            addEdges.resize(type + 1, nullptr);
+        }
+        addEdges[type] = target;
+    }
+
+    void Archetype::setRemoveEdge(ComponentTypeID type, Archetype* target) {
+        if (type >= removeEdges.size()) {
+            removeEdges.resize(type + 1, nullptr);
+        }
+        removeEdges[type] = target;
+    }
+
+    std::pair<std::uint32_t, std::uint32_t> Archetype::allocateRow(EntityID entityID) {
+        if (chunks.empty() || chunks.back().count == chunkCapacity) {
+            Chunk chunk;
+            chunk.data = std::make_unique<std::byte[]>(chunkBytes);
+            chunks.push_back(std::move(chunk));
+        }
+
+        std::uint32_t chunk = static_cast<std::uint32_t>(chunks.size() - 1);
+        std::uint32_t row = chunks[chunk].count++;
+        entities(chunk)[row] = entityID;
+        ++rowCount;
+        return {chunk, row};
+    }
+
+    EntityID Archetype::removeRow(std::uint32_t chunk, std::uint32_t row) {
+        std::uint32_t lastChunk = static_cast<std::uint32_t>(chunks.size() - 1);
+        std::uint32_t lastRow = chunks[lastChunk].count - 1;
+        bool isLast = chunk == lastChunk && row == lastRow;
+
+        EntityID moved = INVALID_ENTITY;
+        for (size_t columnIndex = 0; columnIndex < signature.size(); ++columnIndex) {
+            const ComponentTypeInfo* info = signature[columnIndex];
+            info->destroy(at(chunk, row, columnIndex));
+            if (!isLast) {
+                info->moveConstruct(at(chunk, row, columnIndex), at(lastChunk, lastRow, columnIndex));
+                info->destroy(at(lastChunk, lastRow, columnIndex));
+            }
+        }
+        if (!isLast) {
+            moved = entities(lastChunk)[lastRow];
+            entities(chunk)[row] = moved;
+        }
+
+        --rowCount;
+        if (--chunks[lastChunk].count == 0) {
+            chunks.pop_back();
+        }
+        return moved;
+    }
+
+    Archetype* ArchetypeStorage::findOrCreate(std::vector<const ComponentTypeInfo*> signature) {
+        std::sort(signature.begin(), signature.end(), signatureLess);
+
+        std::vector<ComponentTypeID> key;
+        key.reserve(signature.size());
+        for (const ComponentTypeInfo* info : signature) {
+            key.push_back(info->type);
+        }
+
+        auto it = archetypesBySignature.find(key);
+        if (it != archetypesBySignature.end()) {
+            return it->second;
+        }
+
+        archetypes.push_back(std::make_unique<Archetype>(std::move(signature)));
+        Archetype* archetype = archetypes.back().get();
+        archetypesBySignature.emplace(std::move(key), archetype);
+        return archetype;
+    }
+
+    Archetype* ArchetypeStorage::withComponent(Archetype* source, const ComponentTypeInfo& info) {
+        if (source) {
+            if (Archetype* cached = source->getAddEdge(info.type)) {
+                return cached;
+            }
+        }
+
+        std::vector<const ComponentTypeInfo*> signature;
+        if (source) {
+            signature = source->getSignature();
+        }
+        signature.push_back(&info);
+
+        Archetype* target = findOrCreate(std::move(signature));
+        if (source) {
+            source->setAddEdge(info.type, target);
+            target->setRemoveEdge(info.type, source);
+        }
+        return target;
+    }
+
+    Archetype* ArchetypeStorage::withoutComponent(Archetype* source, ComponentTypeID type) {
+        // Dropping the last component leaves the entity with no archetype
+        if (source->getSignature().size() == 1) {
+            return nullptr;
+        }
+        if (Archetype* cached = source->getRemoveEdge(type)) {
+            return cached;
+        }
+
+        std::vector<const ComponentTypeInfo*> signature;
+        for (const ComponentTypeInfo* info : source->getSignature()) {
+            if (info->type != type) {
+                signature.push_back(info);
+            }
+        }
+
+        Archetype* target = findOrCreate(std::move(signature));
+        source->setRemoveEdge(type, target);
+        target->setAddEdge(type, source);
+        return target;
+    }
+
+    ArchetypeStorage::EntityLocation ArchetypeStorage::moveEntity(EntityID entityID, Archetype* target) {
+        std::uint32_t index = entityIndex(entityID);
+        if (index >= locations.size()) {
+            locations.resize(static_cast<size_t>(index) + 1);
+        }
+        EntityLocation source = locations[index];
+        EntityLocation destination;
+
+        if (target) {
+            auto [chunk, row] = target->allocateRow(entityID);
+            destination = {target, chunk, row};
+        }
+
+        if (source.archetype) {
+            if (target) {
+                const auto& sourceSignature = source.archetype->getSignature();
+                for (size_t columnIndex = 0; columnIndex < sourceSignature.size(); ++columnIndex) {
+                    int targetColumn = target->columnOf(sourceSignature[columnIndex]->type);
+                    if (targetColumn >= 0) {
+                        sourceSignature[columnIndex]->moveConstruct(
+                            target->at(destination.chunk, destination.row, targetColumn),
+                            source.archetype->at(source.chunk, source.row, columnIndex));
+                    }
+                }
+            }
+
+            EntityID moved = source.archetype->removeRow(source.chunk, source.row);
+            if (moved != INVALID_ENTITY) {
+                locations[entityIndex(moved)] = source;
+            }
+        }
+
+        locations[index] = destination;
+        return destination;
+    }
+
+    void ArchetypeStorage::removeComponent(EntityID entityID, ComponentTypeID type) {
+        EntityLocation location = locationOf(entityID);
+        if (!location.archetype || location.archetype->columnOf(type) < 0) {
+            return;
+        }
+        moveEntity(entityID, withoutComponent(location.archetype, type));
+    }
+
+    void ArchetypeStorage::removeAllComponents(EntityID entityID) {
+        if (locationOf(entityID).archetype) {
+            moveEntity(entityID, nullptr);
+        }
+    }
+
+    void ArchetypeStorage::clear() {
+        archetypesBySignature.clear();
+        archetypes.clear();
+        locations.clear();
+    }
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "EntityID.h"
+#include "TypeID.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Type-erased operations needed to store a component in a raw column.
+     */
+    struct ComponentTypeInfo {
+        ComponentTypeID type;
+        size_t size;
+        size_t align;
+        void (*moveConstruct)(void* destination, void* source);
+        void (*destroy)(void* component);
+
+        template<typename ComponentType>
+        static const ComponentTypeInfo& of() {
+            static const ComponentTypeInfo info{
+                componentTypeID<ComponentType>(),
+                sizeof(ComponentType),
+                alignof(ComponentType),
+                [](void* destination, void* source) {
+                    new (destination) ComponentType(std::move(*static_cast<ComponentType*>(source)));
+                },
+                [](void* component) {
+                    static_cast<ComponentType*>(component)->~ComponentType();
+                }
+            };
+            return info;
+        }
+    };
+
+    /**
+     * @brief All entities that have exactly the same set of component types.
+     *
+     * Rows are stored in fixed-size chunks. Each chunk holds one column per
+     * component type plus a column of owning entities, so a query reads
+     * each component type as a contiguous array. Rows stay packed: removing
+     * a row moves the archetype's last row into the hole.
+     */
+    class Archetype {
+    public:
+        static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+        explicit Archetype(std::vector<const ComponentTypeInfo*> signature);
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        const std::vector<const ComponentTypeInfo*>& getSignature() const { return signature; }
+
+        /**
+         * @brief Column index of a component type, or -1 if not in this archetype.
+         */
+        int columnOf(ComponentTypeID type) const {
+            return type < columnByType.size() ? columnByType[type] : -1;
+        }
+
+        size_t size() const { return rowCount; }
+        size_t getChunkCount() const { return chunks.size(); }
+        size_t getChunkCapacity() const { return chunkCapacity; }
+        size_t getChunkSize(size_t chunk) const { return chunks[chunk].count; }
+
+        EntityID* entities(size_t chunk) {
+            return reinterpret_cast<EntityID*>(chunks[chunk].data.get());
+        }
+
+        void* column(size_t chunk, size_t columnIndex) {
+            return chunks[chunk].data.get() + columnOffsets[columnIndex];
+        }
+
+        void* at(size_t chunk, size_t row, size_t columnIndex) {
+            return static_cast<std::byte*>(column(chunk, columnIndex)) + row * signature[columnIndex]->size;
+        }
+
+        /**
+         * @brief Appends an uninitialised row owned by entityID.
+         * @return (chunk, row) of the new row; callers construct every column.
+         */
+        std::pair<std::uint32_t, std::uint32_t> allocateRow(EntityID entityID);
+
+        /**
+         * @brief Destroys a row and fills the hole with the last row.
+         * @return The entity moved into the hole, or INVALID_ENTITY if none moved.
+         */
+        EntityID removeRow(std::uint32_t chunk, std::uint32_t row);
+
+        /**
+         * @brief Cached archetype reached by adding or removing one component type.
+         * @return nullptr if the transition has not been resolved yet.
+         */
+        Archetype* getAddEdge(ComponentTypeID type) const {
+            return type < addEdges.size() ? addEdges[type] : nullptr;
+        }
+        Archetype* getRemoveEdge(ComponentTypeID type) const {
+            return type < removeEdges.size() ? removeEdges[type] : nullptr;
+        }
+        void setAddEdge(ComponentTypeID type, Archetype* target);
+        void setRemoveEdge(ComponentTypeID type, Archetype* target);
+
+    private:
+        struct Chunk {
+            std::unique_ptr<std::byte[]> data;
+            std::uint32_t count = 0;
+        };
+
+        std::vector<const ComponentTypeInfo*> signature;
+        std::vector<int> columnByType;   // Indexed by ComponentTypeID, -1 if absent
+        std::vector<Archetype*> addEdges;     // Indexed by ComponentTypeID
+        std::vector<Archetype*> removeEdges;  // Indexed by ComponentTypeID
+        std::vector<size_t> columnOffsets;
+        size_t chunkCapacity = 0;
+        size_t chunkBytes = 0;
+        std::vector<Chunk> chunks;
+        size_t rowCount = 0;
+    };
+
+    /**
+     * @brief Component storage that groups entities by archetype.
+     *
+     * Adding or removing a component moves the entity's row to the
+     * archetype for its new component set. forEach() visits matching
+     * archetypes chunk by chunk and hands out contiguous columns, so a
+     * query over several components performs no per-entity lookups.
+     *
+     * Component pointers are invalidated by any structural change (add or
+     * remove of any component, or entity destruction). Structural changes
+     * must not be made from inside forEach().
+     */
+    class ArchetypeStorage {
+    public:
+        template<typename ComponentType, typename... Args>
+        ComponentType* addComponent(EntityID entityID, Args&&... args) {
+            const ComponentTypeInfo& info = ComponentTypeInfo::of<ComponentType>();
+            EntityLocation current = locationOf(entityID);
+
+            if (current.archetype) {
+                int existing = current.archetype->columnOf(info.type);
+                if (existing >= 0) {
+                    auto* component = static_cast<ComponentType*>(current.archetype->at(current.chunk, current.row, existing));
+                    *component = ComponentType(std::forward<Args>(args)...);
+                    return component;
+                }
+            }
+
+            Archetype* target = withComponent(current.archetype, info);
+            EntityLocation moved = moveEntity(entityID, target);
+            void* slot = target->at(moved.chunk, moved.row, target->columnOf(info.type));
+            return new (slot) ComponentType(std::forward<Args>(args)...);
+        }
+
+        template<typename ComponentType>
+        ComponentType* getComponent(EntityID entityID) const {
+            EntityLocation location = locationOf(entityID);
+            if (!location.archetype) {
+                return nullptr;
+            }
+            int columnIndex = location.archetype->columnOf(componentTypeID<ComponentType>());
+            if (columnIndex < 0) {
+                return nullptr;
+            }
+            return static_cast<ComponentType*>(location.archetype->at(location.chunk, location.row, columnIndex));
+        }
+
+        template<typename ComponentType>
+        bool hasComponent(EntityID entityID) const {
+            return getComponent<ComponentType>(entityID) != nullptr;
+        }
+
+        template<typename ComponentType>
+        void removeComponent(EntityID entityID) {
+            removeComponent(entityID, componentTypeID<ComponentType>());
+        }
+
+        void removeComponent(EntityID entityID, ComponentTypeID type);
+        void removeAllComponents(EntityID entityID);
+        void clear();
+
+        /**
+         * @brief Calls func(EntityID, Components&...) for every entity that has all Components.
+         */
+        template<typename... Components, typename Func>
+        void forEach(Func&& func) {
+            for (auto& archetype : archetypes) {
+                const int columns[] = { archetype->columnOf(componentTypeID<Components>())... };
+                bool matches = true;
+                for (int columnIndex : columns) {
+                    matches = matches && columnIndex >= 0;
+                }
+                if (!matches) {
+                    continue;
+                }
+
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                    forEachInChunk<Components...>(*archetype, chunk, columns, func,
+                                                  std::index_sequence_for<Components...>{});
+                }
+            }
+        }
+
+        size_t getArchetypeCount() const { return archetypes.size(); }
+
+    private:
+        struct EntityLocation {
+            Archetype* archetype = nullptr;
+            std::uint32_t chunk = 0;
+            std::uint32_t row = 0;
+        };
+
+        std::vector<std::unique_ptr<Archetype>> archetypes;
+        std::map<std::vector<ComponentTypeID>, Archetype*> archetypesBySignature;
+        std::vector<EntityLocation> locations; // Indexed by entityIndex()
+
+        /**
+         * @brief Where the entity's row lives; empty for no components or a stale handle.
+         */
+        EntityLocation locationOf(EntityID entityID) const {
+            std::uint32_t index = entityIndex(entityID);
+            if (index >= locations.size() || !locations[index].archetype) {
+                return EntityLocation{};
+            }
+            const EntityLocation& location = locations[index];
+            if (location.archetype->entities(location.chunk)[location.row] != entityID) {
+                return EntityLocation{};
+            }
+            return location;
+        }
+
+        template<typename... Components, typename Func, size_t... Index>
+        static void forEachInChunk(Archetype& archetype, size_t chunk, const int* columns, Func& func,
+                                   std::index_sequence<Index...>) {
+            const EntityID* ids = archetype.entities(chunk);
+            size_t count = archetype.getChunkSize(chunk);
+            std::tuple<Components*...> arrays{ static_cast<Components*>(archetype.column(chunk, columns[Index]))... };
+            for (size_t row = 0; row < count; ++row) {
+                func(ids[row], std::get<Index>(arrays)[row]...);
+            }
+        }
+
+        Archetype* findOrCreate(std::vector<const ComponentTypeInfo*> signature);
+        Archetype* withComponent(Archetype* source, const ComponentTypeInfo& info);
+        Archetype* withoutComponent(Archetype* source, ComponentTypeID type);
+
+        /**
+         * @brief Moves an entity's row into target, carrying over shared columns.
+         *
+         * Columns that exist only in target are left uninitialised for the
+         * caller; columns that exist only in the source are destroyed.
+         */
+        EntityLocation moveEntity(EntityID entityID, Archetype* target);
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "EntityID.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Logical time used to stamp component additions, changes and removals.
+     *
+     * The world's tick starts at 1 and moves forward each time a reader calls
+     * World::beginChangeRead(), so a reader whose last read tick is 0 sees
+     * everything. At one read per frame a 32-bit tick lasts for years, so
+     * wrap-around is not handled.
+     */
+    using ChangeTick = std::uint32_t;
+
+    /**
+     * @brief When a component was added and when it was last marked changed.
+     */
+    struct ComponentTicks {
+        ChangeTick added;
+        ChangeTick changed;
+    };
+
+    /**
+     * @brief Entity handles in the order they were stamped, oldest first.
+     *
+     * Ticks never decrease, so the records newer than a reader's last read
+     * are found with a binary search and cost is proportional to the number
+     * of changes rather than the number of components.
+     */
+    class ChangeLog {
+    public:
+        struct Record {
+            EntityID entity;
+            ChangeTick tick;
+        };
+
+        using const_iterator = std::vector<Record>::const_iterator;
+
+        void record(EntityID entity, ChangeTick tick) {
+            records.push_back({entity, tick});
+        }
+
+        /**
+         * @brief First record stamped after since.
+         */
+        const_iterator after(ChangeTick since) const {
+            return std::upper_bound(records.begin(), records.end(), since,
+                                    [](ChangeTick tick, const Record& record) { return tick < record.tick; });
+        }
+
+        const_iterator end() const { return records.end(); }
+
+        /**
+         * @brief Keeps only the records for which isCurrent(record) is true, in order.
+         */
+        template<typename Predicate>
+        void compact(Predicate isCurrent) {
+            records.erase(std::remove_if(records.begin(), records.end(),
+                                         [&isCurrent](const Record& record) { return !isCurrent(record); }),
+                          records.end());
+        }
+
+        /**
+         * @brief Drops records stamped at or before tick once they make up half the log.
+         */
+        void expire(ChangeTick tick) {
+            auto expired = after(tick);
+            if (static_cast<size_t>(expired - records.cbegin()) * 2 >= records.size()) {
+                records.erase(records.cbegin(), expired);
+            }
+        }
+
+        size_t size() const { return records.size(); }
+        size_t capacityBytes() const { return records.capacity() * sizeof(Record); }
+        void clear() { records.clear(); }
+
+    private:
+        std::vector<Record> records;
+    };
+}
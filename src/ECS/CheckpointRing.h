@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Fixed number of reusable checkpoint slots, newest first.
+     *
+     * All slots are constructed up front. push() hands back the slot to
+     * overwrite: the next unused one, or the oldest once the ring is full.
+     * Slots are never destroyed, so a Checkpoint type that keeps its
+     * buffers between saves (such as WorldCheckpoint) stops allocating
+     * after one lap of the ring.
+     */
+    template<typename Checkpoint>
+    class CheckpointRing {
+    public:
+        explicit CheckpointRing(size_t capacity) : slots(std::max<size_t>(capacity, 1)) {}
+
+        /**
+         * @brief Slot for a new checkpoint, which becomes the newest one.
+         */
+        Checkpoint& push() {
+            Checkpoint& slot = slots[head];
+            head = (head + 1) % slots.size();
+            count = std::min(count + 1, slots.size());
+            return slot;
+        }
+
+        /**
+         * @brief Checkpoint taken stepsBack pushes before the newest (0 is the newest), or null.
+         */
+        Checkpoint* get(size_t stepsBack) {
+            return stepsBack < count ? &slots[indexOf(stepsBack)] : nullptr;
+        }
+
+        const Checkpoint* get(size_t stepsBack) const {
+            return stepsBack < count ? &slots[indexOf(stepsBack)] : nullptr;
+        }
+
+        /**
+         * @brief Forgets the stepsBack checkpoints newer than the one stepsBack back.
+         *
+         * Used after rewinding so the next push() follows the checkpoint
+         * that was restored. The forgotten slots are reused, not freed.
+         */
+        void discardNewest(size_t stepsBack) {
+            stepsBack = std::min(stepsBack, count);
+            head = (head + slots.size() - stepsBack) % slots.size();
+            count -= stepsBack;
+        }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return slots.size(); }
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief Forgets every checkpoint; the slots and their buffers are kept.
+         */
+        void clear() {
+            head = 0;
+            count = 0;
+        }
+
+    private:
+        std::vector<Checkpoint> slots;
+        size_t head = 0;  // Slot the next push() returns
+        size_t count = 0; // Checkpoints currently held
+
+        size_t indexOf(size_t stepsBack) const {
+            return (head + slots.size() - 1 - stepsBack) % slots.size();
+        }
+    };
+}
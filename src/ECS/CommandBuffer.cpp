@@ -0,0 +1,87 @@
+#include "CommandBuffer.h"
+#include "World.h"
+#include <algorithm>
+#include <cassert>
+
+namespace ECS {
+
+    namespace {
+        thread_local CommandBuffer* currentBuffer = nullptr;
+    }
+
+    CommandBuffer::~CommandBuffer() {
+        clear();
+    }
+
+    void CommandBuffer::playback(World& world, std::vector<EntityID>* created) {
+        std::vector<EntityID>& ids = created ? *created : createdScratch;
+        ids.clear();
+        if (pendingEntityCount > 0) {
+            // Entities past the index limit stay INVALID_ENTITY, which the World treats as dead
+            world.createEntities(pendingEntityCount, ids);
+            ids.resize(pendingEntityCount, INVALID_ENTITY);
+        }
+
+        for (Command& command : commands) {
+            assert(!command.isPending || command.target < ids.size());
+            EntityID target = command.isPending ? ids[command.target] : command.target;
+            command.apply(world, target, command.payload);
+            command.discard = nullptr; // apply consumed the payload
+        }
+
+        commands.clear();
+        pendingEntityCount = 0;
+        currentBlock = 0;
+        blockOffset = 0;
+    }
+
+    void CommandBuffer::clear() {
+        for (Command& command : commands) {
+            if (command.discard) {
+                command.discard(command.payload);
+            }
+        }
+        commands.clear();
+        pendingEntityCount = 0;
+        currentBlock = 0;
+        blockOffset = 0;
+    }
+
+    void* CommandBuffer::allocate(size_t size, size_t align) {
+        if (currentBlock < blocks.size()) {
+            size_t offset = (blockOffset + align - 1) / align * align;
+            if (offset + size <= blocks[currentBlock].capacity) {
+                blockOffset = offset + size;
+                return blocks[currentBlock].data.get() + offset;
+            }
+            ++currentBlock;
+        }
+
+        // Move to the next kept block, replacing it if it is too small for this payload
+        size_t capacity = std::max(BLOCK_BYTES, size);
+        if (currentBlock == blocks.size()) {
+            blocks.push_back({std::make_unique<std::byte[]>(capacity), capacity});
+        } else if (blocks[currentBlock].capacity < size) {
+            blocks[currentBlock] = {std::make_unique<std::byte[]>(capacity), capacity};
+        }
+        blockOffset = size;
+        return blocks[currentBlock].data.get();
+    }
+
+    void CommandBuffer::applyDestroyEntity(World& world, EntityID entityID, void* payload) {
+        (void)payload;
+        world.destroyEntity(entityID);
+    }
+
+    CommandBuffer* CommandBuffer::current() {
+        return currentBuffer;
+    }
+
+    CommandBuffer::Scope::Scope(CommandBuffer* buffer) : previous(currentBuffer) {
+        currentBuffer = buffer;
+    }
+
+    CommandBuffer::Scope::~Scope() {
+        currentBuffer = previous;
+    }
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "EntityID.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ECS {
+    class World;
+
+    // Defined in World.h, where World is complete
+    template<typename ComponentType>
+    void applyAddComponent(World& world, EntityID entityID, void* payload);
+    template<typename ComponentType>
+    void applyRemoveComponent(World& world, EntityID entityID, void* payload);
+
+    /**
+     * @brief Handle to an entity a CommandBuffer will create on playback.
+     */
+    struct PendingEntity {
+        std::uint32_t index;
+    };
+
+    /**
+     * @brief Records structural changes to apply to a World later.
+     *
+     * Creating or destroying entities and adding or removing components
+     * while a system iterates storages (or while other systems run in
+     * parallel) would invalidate their iteration. Recording them here and
+     * calling playback() at a sync point avoids that. Each system gets its
+     * own buffer, so recording never takes a lock.
+     *
+     * Component arguments are moved into block-allocated memory that is
+     * reused between frames. Entities requested with createEntity() are
+     * allocated as one batch at the start of playback, after which the
+     * commands run in the order they were recorded.
+     */
+    class CommandBuffer {
+    public:
+        CommandBuffer() = default;
+        ~CommandBuffer();
+
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /**
+         * @brief Reserves an entity to be created on playback.
+         */
+        PendingEntity createEntity() {
+            return PendingEntity{pendingEntityCount++};
+        }
+
+        void destroyEntity(EntityID entityID) {
+            commands.push_back({entityID, false, nullptr, &applyDestroyEntity, nullptr});
+        }
+
+        template<typename ComponentType, typename... Args>
+        void addComponent(EntityID entityID, Args&&... args) {
+            recordAdd<ComponentType>(entityID, false, std::forward<Args>(args)...);
+        }
+
+        template<typename ComponentType, typename... Args>
+        void addComponent(PendingEntity entity, Args&&... args) {
+            recordAdd<ComponentType>(entity.index, true, std::forward<Args>(args)...);
+        }
+
+        template<typename ComponentType>
+        void removeComponent(EntityID entityID) {
+            commands.push_back({entityID, false, nullptr, &applyRemoveComponent<ComponentType>, nullptr});
+        }
+
+        /**
+         * @brief Applies every recorded change to the world, then clears the buffer.
+         * @param created If given, receives the IDs of entities from createEntity(), by pending index.
+         */
+        void playback(World& world, std::vector<EntityID>* created = nullptr);
+
+        /**
+         * @brief Drops every recorded change without applying it.
+         */
+        void clear();
+
+        bool empty() const { return commands.empty() && pendingEntityCount == 0; }
+        size_t getCommandCount() const { return commands.size(); }
+        std::uint32_t getPendingEntityCount() const { return pendingEntityCount; }
+
+        /**
+         * @brief Buffer that World::commands() returns on this thread, if a system is running.
+         */
+        static CommandBuffer* current();
+
+        /**
+         * @brief Makes a buffer current on this thread for the lifetime of the scope.
+         */
+        class Scope {
+        public:
+            explicit Scope(CommandBuffer* buffer);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            CommandBuffer* previous;
+        };
+
+    private:
+        static constexpr size_t BLOCK_BYTES = 64 * 1024;
+
+        struct Command {
+            std::uint32_t target;                         // EntityID, or pending index if isPending
+            bool isPending;
+            void* payload;                                // Component to move in, if any
+            void (*apply)(World&, EntityID, void*);
+            void (*discard)(void*);                       // Destroys an unapplied payload
+        };
+
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t capacity;
+        };
+
+        std::vector<Command> commands;
+        std::uint32_t pendingEntityCount = 0;
+        std::vector<EntityID> createdScratch;
+
+        // Payload arena; blocks are kept across clear() and refilled from the first
+        std::vector<Block> blocks;
+        size_t currentBlock = 0;
+        size_t blockOffset = 0;
+
+        void* allocate(size_t size, size_t align);
+
+        template<typename ComponentType, typename... Args>
+        void recordAdd(std::uint32_t target, bool isPending, Args&&... args) {
+            static_assert(alignof(ComponentType) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                          "over-aligned components are not supported");
+            void* payload = allocate(sizeof(ComponentType), alignof(ComponentType));
+            new (payload) ComponentType(std::forward<Args>(args)...);
+            commands.push_back({target, isPending, payload, &applyAddComponent<ComponentType>,
+                                [](void* object) { static_cast<ComponentType*>(object)->~ComponentType(); }});
+        }
+
+        static void applyDestroyEntity(World& world, EntityID entityID, void* payload);
+    };
+}
@@ -3,14 +3,60 @@
 namespace ECS {
     
     void ComponentRegistry::removeAllComponents(EntityID entityID) {
-        for (auto& [typeIndex, storage] : storages) {
-            storage->removeComponent(entityID);
+        for (auto& storage : storages) {
+            if (storage) {
+                storage->removeComponent(entityID);
+            }
+        }
+    }
+    
+    PoolStats ComponentRegistry::getPoolStats() const {
+        PoolStats stats;
+        for (const auto& storage : storages) {
+            if (storage) {
+                stats += storage->getPoolStats();
+            }
+        }
+        return stats;
+    }
+    
+    void ComponentRegistry::copyStoragesTo(std::vector<std::unique_ptr<IComponentStorage>>& copies) const {
+        if (copies.size() < storages.size()) {
+            copies.resize(storages.size());
+        }
+        for (size_t typeID = 0; typeID < copies.size(); ++typeID) {
+            const bool used = typeID < storages.size() && storages[typeID];
+            if (!used) {
+                if (copies[typeID]) {
+                    copies[typeID]->clear();
+                }
+                continue;
+            }
+            if (!copies[typeID]) {
+                copies[typeID] = storages[typeID]->cloneEmpty();
+            }
+            copies[typeID]->copyFrom(*storages[typeID]);
+        }
+    }
+    
+    void ComponentRegistry::restoreStorages(const std::vector<std::unique_ptr<IComponentStorage>>& copies) {
+        for (size_t typeID = 0; typeID < storages.size(); ++typeID) {
+            if (!storages[typeID]) {
+                continue;
+            }
+            if (typeID < copies.size() && copies[typeID]) {
+                storages[typeID]->copyFrom(*copies[typeID]);
+            } else {
+                storages[typeID]->clear();
+            }
         }
     }
     
     void ComponentRegistry::clear() {
-        for (auto& [typeIndex, storage] : storages) {
-            storage->clear();
+        for (auto& storage : storages) {
+            if (storage) {
+                storage->clear();
+            }
         }
     }
 }
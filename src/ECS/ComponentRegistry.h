@@ -1,10 +1,20 @@
 #pragma once
 
 #include "EntityID.h"
-#include <typeindex>
-#include <unordered_map>
+#include "TypeID.h"
+#include "ObjectPool.h"
+#include "ChangeTracking.h"
+#include <atomic>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
 #include <cassert>
+#include <cstring>
+#include <typeinfo>
 
 namespace ECS {
     /**
@@ -16,42 +26,406 @@ namespace ECS {
         virtual bool hasComponent(EntityID entityID) const = 0;
         virtual void removeComponent(EntityID entityID) = 0;
         virtual void clear() = 0;
+        virtual size_t size() const = 0;
+        
+        /**
+         * @brief Memory held by this storage; dense packing never strands slots.
+         */
+        virtual PoolStats getPoolStats() const = 0;
+        
+        /**
+         * @brief New empty storage for the same component type, e.g. to hold a checkpoint copy.
+         */
+        virtual std::unique_ptr<IComponentStorage> cloneEmpty() const = 0;
+        
+        /**
+         * @brief Makes this storage an exact copy of other, which must hold the same component type.
+         * 
+         * Existing capacity is reused, so copying between two storages of
+         * similar size does not allocate.
+         */
+        virtual void copyFrom(const IComponentStorage& other) = 0;
+        
+        /**
+         * @brief Incremented whenever an entity gains or loses this component,
+         * or the components move to a new allocation.
+         * 
+         * Cached queries compare versions to know when to rebuild, and
+         * anything holding component pointers knows when to drop them.
+         */
+        std::uint64_t getVersion() const { return version; }
+        
+    protected:
+        std::uint64_t version = 0;
     };
     
     /**
-     * @brief Template specialization for storing components of a specific type.
+     * @brief Sparse-set storage for components of a specific type.
+     * 
+     * Components are packed into a dense array with a parallel array of
+     * owning entities, so iterating a component type is a linear scan over
+     * contiguous memory. A paged sparse index maps an entity's slot index to
+     * its dense slot; pages are only allocated for index ranges that are
+     * actually used. Lookups compare the full handle stored in the dense
+     * entity array, so a stale handle from an earlier generation misses.
+     * Add, get and remove are O(1); removal moves the last element into the
+     * freed slot.
+     * 
+     * Pointers and references returned from this storage are invalidated by
+     * any later add or remove of the same component type.
+     * 
+     * Each slot also carries the tick it was added and last changed at, and
+     * three logs record additions, changes and removals in tick order so
+     * readers can collect what happened since their last read. Adds stamp
+     * both ticks; writes through a reference are only seen after
+     * markChanged(), which counts as a write for system access purposes.
+     * The added and changed logs are compacted to one record per component
+     * once they outgrow the storage. Removals are kept for
+     * REMOVED_HISTORY_TICKS ticks.
      */
     template<typename ComponentType>
-    class ComponentStorage : public IComponentStorage {
-    private:
-        std::unordered_map<EntityID, std::unique_ptr<ComponentType>> components;
-        
+    class ComponentStorage final : public IComponentStorage {
     public:
-        ComponentType* addComponent(EntityID entityID, std::unique_ptr<ComponentType> component) {
-            ComponentType* ptr = component.get();
-            components[entityID] = std::move(component);
-            return ptr;
+        static constexpr size_t PAGE_SIZE = 4096;
+        static constexpr ChangeTick REMOVED_HISTORY_TICKS = 4096;
+        
+        /**
+         * @brief Iterator yielding (EntityID, ComponentType&) pairs for structured bindings.
+         */
+        template<typename Component>
+        class BasicIterator {
+        public:
+            BasicIterator(const EntityID* entity, Component* component) : entity(entity), component(component) {}
+            
+            std::pair<EntityID, Component&> operator*() const { return {*entity, *component}; }
+            BasicIterator& operator++() { ++entity; ++component; return *this; }
+            bool operator==(const BasicIterator& other) const { return entity == other.entity; }
+            bool operator!=(const BasicIterator& other) const { return entity != other.entity; }
+            
+        private:
+            const EntityID* entity;
+            Component* component;
+        };
+        
+        using iterator = BasicIterator<ComponentType>;
+        using const_iterator = BasicIterator<const ComponentType>;
+        
+        /**
+         * @brief Constructs a component in place, replacing any existing one.
+         */
+        template<typename... Args>
+        ComponentType* addComponent(EntityID entityID, Args&&... args) {
+            std::uint32_t& slot = sparseSlot(entityID);
+            if (slot != EMPTY_SLOT) {
+                dense[slot] = ComponentType(std::forward<Args>(args)...);
+                entities[slot] = entityID;
+                markSlotChanged(slot);
+                return &dense[slot];
+            }
+            
+            slot = static_cast<std::uint32_t>(dense.size());
+            dense.emplace_back(std::forward<Args>(args)...);
+            entities.push_back(entityID);
+            
+            ChangeTick tick = currentTick();
+            ticks.push_back({tick, tick});
+            addedLog.record(entityID, tick);
+            changedLog.record(entityID, tick);
+            if (addedLog.size() > compactThreshold()) {
+                addedLog.compact([this](const ChangeLog::Record& record) { return isLatest(record, &ComponentTicks::added); });
+            }
+            if (changedLog.size() > compactThreshold()) {
+                compactChangedLog();
+            }
+            ++version;
+            return &dense.back();
         }
         
-        ComponentType* getComponent(EntityID entityID) const {
-            auto it = components.find(entityID);
-            return (it != components.end()) ? it->second.get() : nullptr;
+        ComponentType* getComponent(EntityID entityID) {
+            std::uint32_t slot = findSlot(entityID);
+            return slot != EMPTY_SLOT ? &dense[slot] : nullptr;
+        }
+        
+        const ComponentType* getComponent(EntityID entityID) const {
+            std::uint32_t slot = findSlot(entityID);
+            return slot != EMPTY_SLOT ? &dense[slot] : nullptr;
         }
         
         bool hasComponent(EntityID entityID) const override {
-            return components.find(entityID) != components.end();
+            return findSlot(entityID) != EMPTY_SLOT;
         }
         
         void removeComponent(EntityID entityID) override {
-            components.erase(entityID);
+            std::uint32_t slot = findSlot(entityID);
+            if (slot == EMPTY_SLOT) {
+                return;
+            }
+            
+            // Swap-and-pop keeps the dense arrays packed
+            std::uint32_t last = static_cast<std::uint32_t>(dense.size() - 1);
+            if (slot != last) {
+                dense[slot] = std::move(dense[last]);
+                entities[slot] = entities[last];
+                ticks[slot] = ticks[last];
+                sparseSlot(entities[slot]) = slot;
+            }
+            dense.pop_back();
+            entities.pop_back();
+            ticks.pop_back();
+            sparseSlot(entityID) = EMPTY_SLOT;
+            
+            ChangeTick tick = currentTick();
+            removedLog.record(entityID, tick);
+            if (tick > REMOVED_HISTORY_TICKS) {
+                removedLog.expire(tick - REMOVED_HISTORY_TICKS);
+            }
+            ++version;
+        }
+        
+        /**
+         * @brief Stamps an entity's component as changed at the current tick.
+         * @return False if the entity has no such component.
+         */
+        bool markChanged(EntityID entityID) {
+            std::uint32_t slot = findSlot(entityID);
+            if (slot == EMPTY_SLOT) {
+                return false;
+            }
+            markSlotChanged(slot);
+            return true;
+        }
+        
+        /**
+         * @brief Appends entities whose component was added after since and is still present.
+         */
+        void collectAdded(ChangeTick since, std::vector<EntityID>& out) const {
+            for (auto it = addedLog.after(since); it != addedLog.end(); ++it) {
+                if (isLatest(*it, &ComponentTicks::added)) {
+                    out.push_back(it->entity);
+                }
+            }
+        }
+        
+        /**
+         * @brief Appends entities whose component was added or marked changed after since.
+         */
+        void collectChanged(ChangeTick since, std::vector<EntityID>& out) const {
+            for (auto it = changedLog.after(since); it != changedLog.end(); ++it) {
+                if (isLatest(*it, &ComponentTicks::changed)) {
+                    out.push_back(it->entity);
+                }
+            }
+        }
+        
+        /**
+         * @brief Appends entities that lost this component after since and have not regained it.
+         * 
+         * Each entity appears once, in ascending ID order. Destroyed entities
+         * are included.
+         */
+        void collectRemoved(ChangeTick since, std::vector<EntityID>& out) const {
+            size_t first = out.size();
+            for (auto it = removedLog.after(since); it != removedLog.end(); ++it) {
+                if (findSlot(it->entity) == EMPTY_SLOT) {
+                    out.push_back(it->entity);
+                }
+            }
+            std::sort(out.begin() + first, out.end());
+            out.erase(std::unique(out.begin() + first, out.end()), out.end());
+        }
+        
+        /**
+         * @brief Added and last-changed ticks of an entity's component, if it has one.
+         */
+        const ComponentTicks* getTicks(EntityID entityID) const {
+            std::uint32_t slot = findSlot(entityID);
+            return slot != EMPTY_SLOT ? &ticks[slot] : nullptr;
         }
         
+        /**
+         * @brief Sets the counter that stamps changes; ComponentRegistry shares one across its storages.
+         */
+        void setChangeClock(const std::atomic<ChangeTick>* clock) { changeClock = clock; }
+        
         void clear() override {
-            components.clear();
+            dense.clear();
+            entities.clear();
+            ticks.clear();
+            pages.clear();
+            addedLog.clear();
+            changedLog.clear();
+            removedLog.clear();
+            ++version;
         }
         
-        const std::unordered_map<EntityID, std::unique_ptr<ComponentType>>& getAllComponents() const {
-            return components;
+        size_t size() const override { return dense.size(); }
+        bool empty() const { return dense.empty(); }
+        
+        std::unique_ptr<IComponentStorage> cloneEmpty() const override {
+            return std::make_unique<ComponentStorage>();
+        }
+        
+        /**
+         * @brief Copies components, ticks, logs and sparse pages from other.
+         * 
+         * Dense columns are copy-assigned element-wise into the existing
+         * buffers; sparse pages are copied with memcpy into pages this
+         * storage already owns. Pages other does not use are refilled with
+         * empty slots rather than freed, so alternating between states of
+         * similar size settles into zero allocations. The change clock is
+         * not copied.
+         */
+        void copyFrom(const IComponentStorage& other) override {
+            assert(typeid(other) == typeid(ComponentStorage));
+            const auto& source = static_cast<const ComponentStorage&>(other);
+            if (&source == this) {
+                return;
+            }
+            dense = source.dense;
+            entities = source.entities;
+            ticks = source.ticks;
+            addedLog = source.addedLog;
+            changedLog = source.changedLog;
+            removedLog = source.removedLog;
+            
+            if (pages.size() < source.pages.size()) {
+                pages.resize(source.pages.size());
+            }
+            for (size_t page = 0; page < pages.size(); ++page) {
+                const bool sourceUsed = page < source.pages.size() && source.pages[page];
+                if (!sourceUsed) {
+                    if (pages[page]) {
+                        std::fill_n(pages[page].get(), PAGE_SIZE, EMPTY_SLOT);
+                    }
+                    continue;
+                }
+                if (!pages[page]) {
+                    pages[page] = std::make_unique<std::uint32_t[]>(PAGE_SIZE);
+                }
+                std::memcpy(pages[page].get(), source.pages[page].get(), PAGE_SIZE * sizeof(std::uint32_t));
+            }
+            ++version;
+        }
+        
+        /**
+         * @brief Reserves dense storage for count components, e.g. before a bulk load.
+         */
+        void reserve(size_t count) {
+            if (count > dense.capacity()) {
+                ++version; // Components are about to move
+            }
+            dense.reserve(count);
+            entities.reserve(count);
+            ticks.reserve(count);
+        }
+        
+        /**
+         * @brief Makes room for count more components, at least doubling capacity when it grows.
+         * 
+         * Repeated batch adds therefore reallocate O(log n) times instead of
+         * once per batch.
+         */
+        void reserveExtra(size_t count) {
+            size_t needed = dense.size() + count;
+            if (needed > dense.capacity()) {
+                reserve(std::max(needed, dense.capacity() * 2));
+            }
+        }
+        
+        PoolStats getPoolStats() const override {
+            PoolStats stats;
+            stats.live = dense.size();
+            stats.capacity = dense.capacity();
+            for (const auto& page : pages) {
+                stats.slabs += page ? 1 : 0;
+            }
+            stats.bytesReserved = dense.capacity() * sizeof(ComponentType) +
+                                  entities.capacity() * sizeof(EntityID) +
+                                  ticks.capacity() * sizeof(ComponentTicks) +
+                                  stats.slabs * PAGE_SIZE * sizeof(std::uint32_t) +
+                                  addedLog.capacityBytes() + changedLog.capacityBytes() +
+                                  removedLog.capacityBytes();
+            return stats;
+        }
+        
+        /**
+         * @brief Owning entity of each dense slot, parallel to getComponents().
+         */
+        const std::vector<EntityID>& getEntities() const { return entities; }
+        
+        std::vector<ComponentType>& getComponents() { return dense; }
+        const std::vector<ComponentType>& getComponents() const { return dense; }
+        
+        iterator begin() { return iterator(entities.data(), dense.data()); }
+        iterator end() { return iterator(entities.data() + entities.size(), dense.data() + dense.size()); }
+        const_iterator begin() const { return const_iterator(entities.data(), dense.data()); }
+        const_iterator end() const { return const_iterator(entities.data() + entities.size(), dense.data() + dense.size()); }
+        
+    private:
+        static constexpr std::uint32_t EMPTY_SLOT = std::numeric_limits<std::uint32_t>::max();
+        
+        std::vector<ComponentType> dense;
+        std::vector<EntityID> entities;
+        std::vector<ComponentTicks> ticks;          // Parallel to dense
+        std::vector<std::unique_ptr<std::uint32_t[]>> pages;
+        
+        const std::atomic<ChangeTick>* changeClock = nullptr;
+        ChangeLog addedLog;
+        ChangeLog changedLog;
+        ChangeLog removedLog;
+        
+        ChangeTick currentTick() const {
+            return changeClock ? changeClock->load(std::memory_order_relaxed) : 0;
+        }
+        
+        // Logs may hold stale records up to twice the live count before compacting
+        size_t compactThreshold() const {
+            return 2 * dense.size() + 64;
+        }
+        
+        void markSlotChanged(std::uint32_t slot) {
+            ChangeTick tick = currentTick();
+            if (ticks[slot].changed == tick) {
+                return; // Already logged this tick
+            }
+            ticks[slot].changed = tick;
+            changedLog.record(entities[slot], tick);
+            if (changedLog.size() > compactThreshold()) {
+                compactChangedLog();
+            }
+        }
+        
+        void compactChangedLog() {
+            changedLog.compact([this](const ChangeLog::Record& record) { return isLatest(record, &ComponentTicks::changed); });
+        }
+        
+        // True if the record is the newest one for a component that still exists
+        bool isLatest(const ChangeLog::Record& record, ChangeTick ComponentTicks::*field) const {
+            std::uint32_t slot = findSlot(record.entity);
+            return slot != EMPTY_SLOT && ticks[slot].*field == record.tick;
+        }
+        
+        std::uint32_t findSlot(EntityID entityID) const {
+            std::uint32_t index = entityIndex(entityID);
+            size_t page = index / PAGE_SIZE;
+            if (page >= pages.size() || !pages[page]) {
+                return EMPTY_SLOT;
+            }
+            std::uint32_t slot = pages[page][index % PAGE_SIZE];
+            return (slot != EMPTY_SLOT && entities[slot] == entityID) ? slot : EMPTY_SLOT;
+        }
+        
+        std::uint32_t& sparseSlot(EntityID entityID) {
+            std::uint32_t index = entityIndex(entityID);
+            size_t page = index / PAGE_SIZE;
+            if (page >= pages.size()) {
+                pages.resize(page + 1);
+            }
+            if (!pages[page]) {
+                pages[page] = std::make_unique<std::uint32_t[]>(PAGE_SIZE);
+                std::fill_n(pages[page].get(), PAGE_SIZE, EMPTY_SLOT);
+            }
+            return pages[page][index % PAGE_SIZE];
         }
     };
     
@@ -63,34 +437,36 @@ namespace ECS {
      */
     class ComponentRegistry {
     private:
-        std::unordered_map<std::type_index, std::unique_ptr<IComponentStorage>> storages;
+        // Indexed by componentTypeID<T>(); null until a type is first stored
+        std::vector<std::unique_ptr<IComponentStorage>> storages;
+        
+        // Shared by every storage; heap-allocated so the registry stays movable
+        std::unique_ptr<std::atomic<ChangeTick>> changeTick = std::make_unique<std::atomic<ChangeTick>>(1);
         
         template<typename ComponentType>
         ComponentStorage<ComponentType>* getStorage() {
-            std::type_index typeIndex = std::type_index(typeid(ComponentType));
-            auto it = storages.find(typeIndex);
+            ComponentTypeID typeID = componentTypeID<ComponentType>();
+            if (typeID >= storages.size()) {
+                storages.resize(typeID + 1);
+            }
             
-            if (it == storages.end()) {
+            if (!storages[typeID]) {
                 // Create new storage for this component type
                 auto storage = std::make_unique<ComponentStorage<ComponentType>>();
-                ComponentStorage<ComponentType>* ptr = storage.get();
-                storages[typeIndex] = std::move(storage);
-                return ptr;
+                storage->setChangeClock(changeTick.get());
+                storages[typeID] = std::move(storage);
             }
             
-            return static_cast<ComponentStorage<ComponentType>*>(it->second.get());
+            return static_cast<ComponentStorage<ComponentType>*>(storages[typeID].get());
         }
         
         template<typename ComponentType>
-        const ComponentStorage<ComponentType>* getStorage() const {
-            std::type_index typeIndex = std::type_index(typeid(ComponentType));
-            auto it = storages.find(typeIndex);
-            
-            if (it == storages.end()) {
+        ComponentStorage<ComponentType>* findStorage() const {
+            ComponentTypeID typeID = componentTypeID<ComponentType>();
+            if (typeID >= storages.size()) {
                 return nullptr;
             }
-            
-            return static_cast<const ComponentStorage<ComponentType>*>(it->second.get());
+            return static_cast<ComponentStorage<ComponentType>*>(storages[typeID].get());
         }
         
     public:
@@ -99,9 +475,8 @@ namespace ECS {
          */
         template<typename ComponentType, typename... Args>
         ComponentType* addComponent(EntityID entityID, Args&&... args) {
-            auto component = std::make_unique<ComponentType>(std::forward<Args>(args)...);
             auto* storage = getStorage<ComponentType>();
-            return storage->addComponent(entityID, std::move(component));
+            return storage->addComponent(entityID, std::forward<Args>(args)...);
         }
         
         /**
@@ -109,15 +484,8 @@ namespace ECS {
          */
         template<typename ComponentType>
         ComponentType* getComponent(EntityID entityID) const {
-            std::type_index typeIndex = std::type_index(typeid(ComponentType));
-            auto it = storages.find(typeIndex);
-            
-            if (it == storages.end()) {
-                return nullptr;
-            }
-            
-            auto* storage = static_cast<ComponentStorage<ComponentType>*>(it->second.get());
-            return storage->getComponent(entityID);
+            auto* storage = findStorage<ComponentType>();
+            return storage ? storage->getComponent(entityID) : nullptr;
         }
         
         /**
@@ -125,14 +493,8 @@ namespace ECS {
          */
         template<typename ComponentType>
         bool hasComponent(EntityID entityID) const {
-            std::type_index typeIndex = std::type_index(typeid(ComponentType));
-            auto it = storages.find(typeIndex);
-            
-            if (it == storages.end()) {
-                return false;
-            }
-            
-            return it->second->hasComponent(entityID);
+            auto* storage = findStorage<ComponentType>();
+            return storage && storage->hasComponent(entityID);
         }
         
         /**
@@ -140,11 +502,8 @@ namespace ECS {
          */
         template<typename ComponentType>
         void removeComponent(EntityID entityID) {
-            std::type_index typeIndex = std::type_index(typeid(ComponentType));
-            auto it = storages.find(typeIndex);
-            
-            if (it != storages.end()) {
-                it->second->removeComponent(entityID);
+            if (auto* storage = findStorage<ComponentType>()) {
+                storage->removeComponent(entityID);
             }
         }
         
@@ -154,18 +513,60 @@ namespace ECS {
         void removeAllComponents(EntityID entityID);
         
         /**
-         * @brief Gets all components of a specific type.
+         * @brief Gets the storage holding all components of a specific type.
+         * 
+         * The storage is iterable as (EntityID, ComponentType&) pairs in
+         * dense order.
          */
         template<typename ComponentType>
-        const std::unordered_map<EntityID, std::unique_ptr<ComponentType>>& getAllComponents() const {
-            auto* storage = getStorage<ComponentType>();
+        ComponentStorage<ComponentType>& getAllComponents() {
+            return *getStorage<ComponentType>();
+        }
+        
+        template<typename ComponentType>
+        const ComponentStorage<ComponentType>& getAllComponents() const {
+            const auto* storage = findStorage<ComponentType>();
             if (!storage) {
-                static const std::unordered_map<EntityID, std::unique_ptr<ComponentType>> empty;
+                static const ComponentStorage<ComponentType> empty;
                 return empty;
             }
-            return storage->getAllComponents();
+            return *storage;
+        }
+        
+        /**
+         * @brief Tick that additions, changes and removals are currently stamped with.
+         */
+        ChangeTick getChangeTick() const {
+            return changeTick->load(std::memory_order_relaxed);
+        }
+        
+        /**
+         * @brief Moves to the next change tick and returns the one just closed.
+         */
+        ChangeTick advanceChangeTick() {
+            return changeTick->fetch_add(1, std::memory_order_relaxed);
         }
         
+        /**
+         * @brief Combined occupancy of every component storage.
+         */
+        PoolStats getPoolStats() const;
+        
+        /**
+         * @brief Copies every storage into copies, indexed by component type ID.
+         * 
+         * Copies left over from an earlier call are overwritten in place.
+         */
+        void copyStoragesTo(std::vector<std::unique_ptr<IComponentStorage>>& copies) const;
+        
+        /**
+         * @brief Overwrites every storage from copies made by copyStoragesTo().
+         * 
+         * Storages for component types that had none at the time of the copy
+         * are cleared.
+         */
+        void restoreStorages(const std::vector<std::unique_ptr<IComponentStorage>>& copies);
+        
         /**
          * @brief Clears all components.
          */
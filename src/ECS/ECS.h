@@ -24,6 +24,20 @@
  * - Proper system architecture with ISystem interface
  * - Automatic entity lifecycle management
  * - Component registry for efficient storage
+ * - Optional archetype backend: ECS::World world(ECS::World::StorageBackend::Archetype);
+ * - Multi-component iteration with world.forEach<Movement, PositionComponent>(...)
+ * - Joins: for (auto [id, pos, move] : world.view<PositionComponent, Movement>(ECS::exclude<AIState>))
+ * - Cached joins that rebuild only on membership changes: world.query<PositionComponent, Movement>()
+ * - Systems declare reads/writes in declareAccess(); world.setWorkerThreads(n) runs non-conflicting ones in parallel
+ * - Structural changes from systems go through world.commands() and apply at world.flushCommands()
+ * - Change detection: world.view<AIState>(ECS::Changed<Movement>(world.beginChangeRead(lastRead)))
+ *   visits only entities whose Movement was added or markChanged() since the last read; also Added<T>, Removed<T>
+ * - Events: world.events().emit(MovementPhaseChanged{...}); subscribers get batches at world.events().dispatch()
+ * - Binary snapshots: specialize ECS::SnapshotTraits<T>, register it with a WorldSerializer, then save()/load()
+ * - Tags: empty structs kept as bits in a per-entity signature; world.addTag<PlayerTag>(id),
+ *   world.view<Movement>(ECS::withTags<PlayerTag>()), world.countTagged(ECS::withTags<CitizenTag>())
+ * - Prefabs: ECS::Prefab().set(Movement(64.0f)).tag<CitizenTag>().spawnBatch(world, count, out)
+ * - In-memory rollback: world.saveCheckpoint(ring.push()) / world.restoreCheckpoint(*ring.get(n)) with a CheckpointRing<WorldCheckpoint>
  * 
  * USAGE EXAMPLE:
  * =============
@@ -51,10 +65,21 @@
 
 // Core ECS framework
 #include "EntityID.h"
+#include "TypeID.h"
+#include "ObjectPool.h"
+#include "ChangeTracking.h"
+#include "Tags.h"
+#include "ThreadPool.h"
 #include "EntityManager.h"
 #include "ComponentRegistry.h"
+#include "ArchetypeStorage.h"
+#include "View.h"
+#include "CommandBuffer.h"
+#include "EventBus.h"
 #include "SystemManager.h"
 #include "World.h"
+#include "CheckpointRing.h"
+#include "Prefab.h"
 
 // Base interfaces
 #include "IComponent.h"
@@ -71,7 +96,6 @@
 
 // Migration utilities
 #include "MigrationExample.h"
-#include "LegacyManagerAdapter.h"
 
 namespace ECS {
     /**
@@ -9,14 +9,36 @@ namespace ECS {
      * 
      * This replaces the inconsistent use of std::uint64_t and unsigned int
      * across different managers.
+     * 
+     * The low ENTITY_INDEX_BITS select a slot in the EntityManager and
+     * component storages; the high bits hold that slot's generation, which
+     * is bumped every time the slot is recycled. A handle kept after its
+     * entity was destroyed therefore never matches the slot's next owner.
      */
     using EntityID = std::uint32_t;
     
+    constexpr unsigned ENTITY_INDEX_BITS = 20;
+    constexpr unsigned ENTITY_GENERATION_BITS = 32 - ENTITY_INDEX_BITS;
+    constexpr EntityID ENTITY_INDEX_MASK = (EntityID(1) << ENTITY_INDEX_BITS) - 1;
+    constexpr EntityID ENTITY_GENERATION_MASK = (EntityID(1) << ENTITY_GENERATION_BITS) - 1;
+    
     /**
      * @brief Invalid/null entity ID constant.
      */
     constexpr EntityID INVALID_ENTITY = std::numeric_limits<EntityID>::max();
     
+    constexpr std::uint32_t entityIndex(EntityID id) {
+        return id & ENTITY_INDEX_MASK;
+    }
+    
+    constexpr std::uint32_t entityGeneration(EntityID id) {
+        return id >> ENTITY_INDEX_BITS;
+    }
+    
+    constexpr EntityID makeEntityID(std::uint32_t index, std::uint32_t generation) {
+        return (EntityID(generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+    }
+    
     /**
      * @brief Checks if an entity ID is valid.
      */
@@ -3,55 +3,137 @@
 
 namespace ECS {
     
+    namespace {
+        // Grows geometrically so repeated small batches don't reallocate every call
+        template<typename T>
+        void reserveExtra(std::vector<T>& vec, size_t extra) {
+            size_t needed = vec.size() + extra;
+            if (needed > vec.capacity()) {
+                vec.reserve(std::max(needed, vec.capacity() * 2));
+            }
+        }
+    }
+    
+    EntityManager::EntityManager() {
+        clear();
+    }
+    
     EntityID EntityManager::createEntity() {
-        EntityID newID;
+        std::uint32_t index;
         
-        if (!freeEntityIDs.empty()) {
-            // Reuse a previously destroyed entity ID
-            newID = freeEntityIDs.front();
-            freeEntityIDs.pop();
+        if (freeHead != NO_FREE_INDEX) {
+            // Reuse a destroyed slot; it already carries its new generation
+            index = freeHead;
+            freeHead = entityIndex(slots[index]);
+            slots[index] = makeEntityID(index, entityGeneration(slots[index]));
         } else {
-            // Create a new ID
-            newID = nextEntityID++;
-            
-            // Handle overflow (extremely unlikely with uint32_t)
-            if (newID == INVALID_ENTITY) {
-                newID = 1; // Wrap around to 1, skip 0 (invalid)
-                nextEntityID = 2;
+            index = static_cast<std::uint32_t>(slots.size());
+            if (index >= NO_FREE_INDEX) {
+                return INVALID_ENTITY; // Every index is in use
             }
+            slots.push_back(makeEntityID(index, 0));
+            livingPosition.push_back(0);
+            tags.push_back(0);
         }
         
-        livingEntities.insert(newID);
-        return newID;
+        livingPosition[index] = static_cast<std::uint32_t>(livingEntities.size());
+        livingEntities.push_back(slots[index]);
+        return slots[index];
+    }
+    
+    size_t EntityManager::createEntities(size_t count, std::vector<EntityID>& out) {
+        // Apart from reserved slot 0, every index below NO_FREE_INDEX is living or free
+        count = std::min(count, static_cast<size_t>(NO_FREE_INDEX) - 1 - livingEntities.size());
+        reserveExtra(out, count);
+        reserveExtra(livingEntities, count);
+        reserveExtra(slots, count);
+        reserveExtra(livingPosition, count);
+        reserveExtra(tags, count);
+        
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(createEntity());
+        }
+        return count;
     }
     
     bool EntityManager::destroyEntity(EntityID entityID) {
-        if (!isValidEntity(entityID) || livingEntities.find(entityID) == livingEntities.end()) {
+        if (!isAlive(entityID)) {
             return false; // Entity doesn't exist
         }
         
-        livingEntities.erase(entityID);
-        freeEntityIDs.push(entityID); // Mark for reuse
+        std::uint32_t index = entityIndex(entityID);
+        
+        // Swap-and-pop from the packed living array
+        std::uint32_t position = livingPosition[index];
+        EntityID last = livingEntities.back();
+        livingEntities[position] = last;
+        livingPosition[entityIndex(last)] = position;
+        livingEntities.pop_back();
+        
+        tags[index] = 0;
+        
+        // Bump the generation so stale handles stop matching, then link into the free list
+        std::uint32_t generation = (entityGeneration(entityID) + 1) & ENTITY_GENERATION_MASK;
+        slots[index] = makeEntityID(freeHead, generation);
+        freeHead = index;
         return true;
     }
     
     bool EntityManager::isAlive(EntityID entityID) const {
-        return isValidEntity(entityID) && livingEntities.find(entityID) != livingEntities.end();
+        std::uint32_t index = entityIndex(entityID);
+        return index < slots.size() && slots[index] == entityID;
+    }
+    
+    bool EntityManager::addTags(EntityID entityID, TagMask mask) {
+        if (!isAlive(entityID)) {
+            return false;
+        }
+        tags[entityIndex(entityID)] |= mask;
+        return true;
+    }
+    
+    bool EntityManager::removeTags(EntityID entityID, TagMask mask) {
+        if (!isAlive(entityID)) {
+            return false;
+        }
+        tags[entityIndex(entityID)] &= ~mask;
+        return true;
     }
     
     size_t EntityManager::getEntityCount() const {
         return livingEntities.size();
     }
     
-    std::vector<EntityID> EntityManager::getAllEntities() const {
-        return std::vector<EntityID>(livingEntities.begin(), livingEntities.end());
+    bool EntityManager::restore(std::span<const EntityID> savedSlots, std::uint32_t savedFreeHead,
+                                std::span<const EntityID> living) {
+        if (savedSlots.empty() || savedSlots[0] != INVALID_ENTITY ||
+            (savedFreeHead != NO_FREE_INDEX && savedFreeHead >= savedSlots.size())) {
+            clear();
+            return false;
+        }
+        
+        slots.assign(savedSlots.begin(), savedSlots.end());
+        freeHead = savedFreeHead;
+        livingEntities.assign(living.begin(), living.end());
+        livingPosition.assign(slots.size(), 0);
+        tags.assign(slots.size(), 0);
+        for (size_t position = 0; position < livingEntities.size(); ++position) {
+            EntityID entityID = livingEntities[position];
+            if (!isAlive(entityID)) {
+                clear();
+                return false;
+            }
+            livingPosition[entityIndex(entityID)] = static_cast<std::uint32_t>(position);
+        }
+        return true;
     }
     
     void EntityManager::clear() {
         livingEntities.clear();
-        while (!freeEntityIDs.empty()) {
-            freeEntityIDs.pop();
-        }
-        nextEntityID = 1;
+        livingPosition.assign(1, 0);
+        tags.assign(1, 0);
+        // Slot 0 is reserved; its index bits never match a handle for index 0
+        slots.assign(1, INVALID_ENTITY);
+        freeHead = NO_FREE_INDEX;
     }
 }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "EntityID.h"
+#include "Tags.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
-#include <unordered_set>
-#include <queue>
 
 namespace ECS {
     /**
@@ -11,14 +13,26 @@ namespace ECS {
      * 
      * This centralizes entity management and provides a consistent
      * interface for entity operations across the entire ECS system.
+     * 
+     * Each slot index has one entry in a dense array. A live slot holds the
+     * full handle of its entity, so isAlive() is a single compare. A free
+     * slot holds the next free index and its bumped generation, forming an
+     * intrusive free list with no extra allocation. Living handles are also
+     * kept packed for iteration.
      */
     class EntityManager {
     private:
-        EntityID nextEntityID = 1; // Start from 1, 0 reserved for invalid
-        std::unordered_set<EntityID> livingEntities;
-        std::queue<EntityID> freeEntityIDs; // Reuse destroyed entity IDs
+        static constexpr std::uint32_t NO_FREE_INDEX = ENTITY_INDEX_MASK;
+        
+        std::vector<EntityID> slots;            // Indexed by entityIndex(); slot 0 is never issued
+        std::uint32_t freeHead = NO_FREE_INDEX; // First slot on the free list
+        std::vector<EntityID> livingEntities;   // Packed handles of living entities
+        std::vector<std::uint32_t> livingPosition; // Slot index -> position in livingEntities
+        std::vector<TagMask> tags;              // Slot index -> tag signature; zero for free slots
         
     public:
+        EntityManager();
+        
         /**
          * @brief Creates a new entity and returns its ID.
          * @return EntityID The unique identifier for the new entity.
@@ -26,7 +40,17 @@ namespace ECS {
         EntityID createEntity();
         
         /**
-         * @brief Destroys an entity and marks its ID for reuse.
+         * @brief Creates count entities at once, appending their IDs to out.
+         * 
+         * Storage for the whole batch is reserved up front, so large spawns
+         * grow each array at most once. Stops early when the index space is
+         * used up, so out never receives INVALID_ENTITY.
+         * @return size_t How many entities were created.
+         */
+        size_t createEntities(size_t count, std::vector<EntityID>& out);
+        
+        /**
+         * @brief Destroys an entity and puts its slot on the free list with a new generation.
          * @param entityID The ID of the entity to destroy.
          * @return bool True if the entity was successfully destroyed, false if ID was invalid.
          */
@@ -47,9 +71,49 @@ namespace ECS {
         
         /**
          * @brief Gets all living entity IDs.
-         * @return std::vector<EntityID> Vector containing all living entity IDs.
+         * @return Packed array of living handles, valid until the next create or destroy.
+         */
+        const std::vector<EntityID>& getAllEntities() const { return livingEntities; }
+        
+        /**
+         * @brief Tag signature of an entity; zero if it has none or is not alive.
+         */
+        TagMask getTags(EntityID entityID) const {
+            return isAlive(entityID) ? tags[entityIndex(entityID)] : 0;
+        }
+        
+        /**
+         * @brief Sets the bits of mask in an entity's signature.
+         * @return bool False if the entity is not alive.
+         */
+        bool addTags(EntityID entityID, TagMask mask);
+        
+        /**
+         * @brief Clears the bits of mask in an entity's signature.
+         * @return bool False if the entity is not alive.
+         */
+        bool removeTags(EntityID entityID, TagMask mask);
+        
+        /**
+         * @brief Tag signatures indexed by slot, parallel to getSlots(); free slots hold zero.
+         */
+        const std::vector<TagMask>& getTagMasks() const { return tags; }
+        
+        /**
+         * @brief Per-slot handles (live) or free-list links (free), for snapshots.
+         */
+        const std::vector<EntityID>& getSlots() const { return slots; }
+        std::uint32_t getFreeHead() const { return freeHead; }
+        
+        /**
+         * @brief Replaces all state with a saved slot array, free-list head and living order.
+         * 
+         * Restored entities start with no tags. Existing capacity is reused,
+         * so restoring a same-sized state does not allocate.
+         * @return bool False (leaving the manager cleared) if the data is inconsistent.
          */
-        std::vector<EntityID> getAllEntities() const;
+        bool restore(std::span<const EntityID> savedSlots, std::uint32_t savedFreeHead,
+                     std::span<const EntityID> living);
         
         /**
          * @brief Clears all entities (for cleanup/reset).
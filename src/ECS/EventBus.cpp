@@ -0,0 +1,23 @@
+#include "EventBus.h"
+
+namespace ECS {
+    
+    size_t EventBus::dispatch() {
+        size_t delivered = 0;
+        // Index loop: a subscriber may emit a new event type and grow the queue list
+        for (size_t i = 0; i < queues.size(); ++i) {
+            if (queues[i]) {
+                delivered += queues[i]->dispatch();
+            }
+        }
+        return delivered;
+    }
+    
+    void EventBus::clear() {
+        for (auto& queue : queues) {
+            if (queue) {
+                queue->clear();
+            }
+        }
+    }
+}
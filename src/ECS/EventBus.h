@@ -0,0 +1,169 @@
+#pragma once
+
+#include "TypeID.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ECS {
+    struct EventTypeFamily {};
+
+    using SubscriptionID = std::uint32_t;
+
+    /**
+     * @brief Base class for type-erased event queues.
+     */
+    class IEventQueue {
+    public:
+        virtual ~IEventQueue() = default;
+
+        /**
+         * @brief Hands every queued event to every subscriber in one batch.
+         * @return Number of events delivered.
+         */
+        virtual size_t dispatch() = 0;
+        virtual void clear() = 0;
+        virtual size_t pending() const = 0;
+    };
+
+    /**
+     * @brief Queue and subscriber list for one event type.
+     *
+     * Events are plain values copied into a vector whose capacity is kept
+     * between frames, so emitting does not allocate once the queue has
+     * grown to its peak. Dispatch swaps in a second buffer first: events
+     * emitted by a subscriber while a batch is being delivered are queued
+     * for the next dispatch rather than growing the current batch.
+     */
+    template<typename EventType>
+    class EventQueue final : public IEventQueue {
+    public:
+        using Handler = std::function<void(std::span<const EventType>)>;
+
+        void emit(const EventType& event) {
+            queued.push_back(event);
+        }
+
+        SubscriptionID subscribe(Handler handler) {
+            handlers.push_back(std::move(handler));
+            return static_cast<SubscriptionID>(handlers.size() - 1);
+        }
+
+        void unsubscribe(SubscriptionID id) {
+            if (id < handlers.size()) {
+                handlers[id] = nullptr; // Keep later IDs valid
+            }
+        }
+
+        size_t dispatch() override {
+            if (queued.empty()) {
+                return 0;
+            }
+            delivering.swap(queued);
+            std::span<const EventType> batch(delivering);
+            for (const Handler& handler : handlers) {
+                if (handler) {
+                    handler(batch);
+                }
+            }
+            size_t count = delivering.size();
+            delivering.clear();
+            return count;
+        }
+
+        void clear() override { queued.clear(); }
+        size_t pending() const override { return queued.size(); }
+
+    private:
+        std::vector<EventType> queued;
+        std::vector<EventType> delivering;
+        std::vector<Handler> handlers;
+    };
+
+    /**
+     * @brief Typed, batched event queues keyed by event type.
+     *
+     * Code that notices something (a movement phase flipping, an NPC
+     * reaching a zone) emits a small value event; subscribers receive all
+     * events of a type as one span when dispatch() runs, at whatever point
+     * in the frame the owner calls it. Subscribers therefore only do work
+     * proportional to the number of events instead of polling every entity.
+     *
+     * Event types must be trivially copyable so queuing never allocates.
+     * Queues are dispatched in the order their event types were first
+     * used. Not thread-safe: emit from serial code or from one system at a
+     * time.
+     */
+    class EventBus {
+    public:
+        template<typename EventType>
+        void emit(const EventType& event) {
+            getQueue<EventType>().emit(event);
+        }
+
+        template<typename EventType, typename... Args>
+        void emit(Args&&... args) {
+            getQueue<EventType>().emit(EventType{std::forward<Args>(args)...});
+        }
+
+        /**
+         * @brief Registers handler(std::span<const EventType>) for every dispatched batch.
+         */
+        template<typename EventType, typename Handler>
+        SubscriptionID subscribe(Handler&& handler) {
+            return getQueue<EventType>().subscribe(std::forward<Handler>(handler));
+        }
+
+        template<typename EventType>
+        void unsubscribe(SubscriptionID id) {
+            getQueue<EventType>().unsubscribe(id);
+        }
+
+        /**
+         * @brief Delivers queued events of one type only.
+         */
+        template<typename EventType>
+        size_t dispatch() {
+            return getQueue<EventType>().dispatch();
+        }
+
+        /**
+         * @brief Delivers every queued event, one batch per type.
+         * @return Number of events delivered.
+         */
+        size_t dispatch();
+
+        template<typename EventType>
+        size_t pending() const {
+            std::uint32_t typeID = TypeIndexer<EventTypeFamily>::get<EventType>();
+            return typeID < queues.size() && queues[typeID] ? queues[typeID]->pending() : 0;
+        }
+
+        /**
+         * @brief Drops queued events; subscriptions are kept.
+         */
+        void clear();
+
+    private:
+        // Indexed by event type ID; null until a type is first used
+        std::vector<std::unique_ptr<IEventQueue>> queues;
+
+        template<typename EventType>
+        EventQueue<EventType>& getQueue() {
+            static_assert(std::is_trivially_copyable_v<EventType>, "events must be trivially copyable");
+            std::uint32_t typeID = TypeIndexer<EventTypeFamily>::get<EventType>();
+            if (typeID >= queues.size()) {
+                queues.resize(typeID + 1);
+            }
+            if (!queues[typeID]) {
+                queues[typeID] = std::make_unique<EventQueue<EventType>>();
+            }
+            return static_cast<EventQueue<EventType>&>(*queues[typeID]);
+        }
+    };
+}
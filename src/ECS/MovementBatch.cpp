@@ -0,0 +1,138 @@
+#include "MovementBatch.h"
+#include <cmath>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BRENDA_MOVEMENT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    struct KernelArgs {
+        float* x;
+        float* y;
+        const float* targetX;
+        const float* targetY;
+        const float* speed;
+        std::uint64_t* arrivals;
+        size_t count;     // Multiple of MovementBatch::LANES
+        float deltaTime;
+        float timeScale;
+    };
+
+    using Kernel = void (*)(const KernelArgs&);
+
+    // Every kernel evaluates exactly this, lane by lane, with no fused multiply-adds
+    [[maybe_unused]] void advanceScalar(const KernelArgs& args) {
+        for (size_t i = 0; i < args.count; ++i) {
+            float dx = args.targetX[i] - args.x[i];
+            float dy = args.targetY[i] - args.y[i];
+            float distance = std::sqrt(dx * dx + dy * dy);
+            float moveDistance = args.speed[i] * args.deltaTime * args.timeScale;
+
+            if (distance <= moveDistance) {
+                args.x[i] = args.targetX[i];
+                args.y[i] = args.targetY[i];
+                args.arrivals[i / 64] |= std::uint64_t{1} << (i % 64);
+            } else {
+                args.x[i] += (dx / distance) * moveDistance;
+                args.y[i] += (dy / distance) * moveDistance;
+            }
+        }
+    }
+
+#ifdef BRENDA_MOVEMENT_X86
+    // SSE2 is part of x86-64, so this needs no runtime check
+    void advanceSse2(const KernelArgs& args) {
+        const __m128 deltaTime = _mm_set1_ps(args.deltaTime);
+        const __m128 timeScale = _mm_set1_ps(args.timeScale);
+
+        for (size_t i = 0; i < args.count; i += 4) {
+            __m128 x = _mm_load_ps(args.x + i);
+            __m128 y = _mm_load_ps(args.y + i);
+            __m128 targetX = _mm_load_ps(args.targetX + i);
+            __m128 targetY = _mm_load_ps(args.targetY + i);
+            __m128 dx = _mm_sub_ps(targetX, x);
+            __m128 dy = _mm_sub_ps(targetY, y);
+            __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+            __m128 moveDistance = _mm_mul_ps(_mm_mul_ps(_mm_load_ps(args.speed + i), deltaTime), timeScale);
+
+            // Arrived lanes divide by a zero distance; their result is discarded below
+            __m128 arrived = _mm_cmple_ps(distance, moveDistance);
+            __m128 stepX = _mm_add_ps(x, _mm_mul_ps(_mm_div_ps(dx, distance), moveDistance));
+            __m128 stepY = _mm_add_ps(y, _mm_mul_ps(_mm_div_ps(dy, distance), moveDistance));
+            _mm_store_ps(args.x + i, _mm_or_ps(_mm_and_ps(arrived, targetX), _mm_andnot_ps(arrived, stepX)));
+            _mm_store_ps(args.y + i, _mm_or_ps(_mm_and_ps(arrived, targetY), _mm_andnot_ps(arrived, stepY)));
+
+            std::uint64_t mask = static_cast<unsigned>(_mm_movemask_ps(arrived));
+            args.arrivals[i / 64] |= mask << (i % 64);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void advanceAvx2(const KernelArgs& args) {
+        const __m256 deltaTime = _mm256_set1_ps(args.deltaTime);
+        const __m256 timeScale = _mm256_set1_ps(args.timeScale);
+
+        for (size_t i = 0; i < args.count; i += 8) {
+            __m256 x = _mm256_load_ps(args.x + i);
+            __m256 y = _mm256_load_ps(args.y + i);
+            __m256 targetX = _mm256_load_ps(args.targetX + i);
+            __m256 targetY = _mm256_load_ps(args.targetY + i);
+            __m256 dx = _mm256_sub_ps(targetX, x);
+            __m256 dy = _mm256_sub_ps(targetY, y);
+            __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+            __m256 moveDistance = _mm256_mul_ps(_mm256_mul_ps(_mm256_load_ps(args.speed + i), deltaTime), timeScale);
+
+            __m256 arrived = _mm256_cmp_ps(distance, moveDistance, _CMP_LE_OQ);
+            __m256 stepX = _mm256_add_ps(x, _mm256_mul_ps(_mm256_div_ps(dx, distance), moveDistance));
+            __m256 stepY = _mm256_add_ps(y, _mm256_mul_ps(_mm256_div_ps(dy, distance), moveDistance));
+            _mm256_store_ps(args.x + i, _mm256_blendv_ps(stepX, targetX, arrived));
+            _mm256_store_ps(args.y + i, _mm256_blendv_ps(stepY, targetY, arrived));
+
+            std::uint64_t mask = static_cast<unsigned>(_mm256_movemask_ps(arrived));
+            args.arrivals[i / 64] |= mask << (i % 64);
+        }
+    }
+#endif
+
+    struct KernelChoice {
+        Kernel kernel;
+        const char* name;
+    };
+
+    const KernelChoice& selectKernel() {
+        static const KernelChoice choice = []() -> KernelChoice {
+#ifdef BRENDA_MOVEMENT_X86
+            if (__builtin_cpu_supports("avx2")) {
+                return {&advanceAvx2, "avx2"};
+            }
+            return {&advanceSse2, "sse2"};
+#else
+            return {&advanceScalar, "scalar"};
+#endif
+        }();
+        return choice;
+    }
+}
+
+void MovementBatch::advance(float deltaTime, float timeScale) {
+    // Columns may hold more lanes from a busier frame; only cover this one
+    const size_t padded = (count + LANES - 1) / LANES * LANES;
+    arrivals.assign((padded + 63) / 64, 0);
+    if (count == 0) {
+        return;
+    }
+
+    KernelArgs args{x.data(), y.data(), targetX.data(), targetY.data(), speed.data(),
+                    arrivals.data(), padded, deltaTime, timeScale};
+    selectKernel().kernel(args);
+
+    // Padding lanes may have set bits past the last live entry
+    if (count % 64 != 0) {
+        arrivals[count / 64] &= (std::uint64_t{1} << (count % 64)) - 1;
+    }
+}
+
+const char* MovementBatch::getKernelName() {
+    return selectKernel().name;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Positions, targets and speeds of moving entities as aligned columns.
+ *
+ * MovementManager gathers every MOVING entity into a batch, advances the
+ * whole batch with one vectorized kernel and scatters the results back.
+ * The kernel is picked once at runtime: AVX2 (8 lanes) when the CPU has
+ * it, otherwise SSE2 (4 lanes) on x86-64, otherwise a scalar loop. All
+ * three compute the same expression as the old per-entity code, so the
+ * results are bit-identical whichever one runs.
+ *
+ * Columns are 32-byte aligned and always padded to a whole number of
+ * LANES, so the kernels never need a scalar tail. Padding lanes are
+ * computed and ignored.
+ */
+class MovementBatch {
+public:
+    static constexpr size_t LANES = 8;
+
+    /**
+     * @brief Empties the batch; column capacity is kept for the next frame.
+     */
+    void clear() { count = 0; }
+
+    void push(float posX, float posY, float destX, float destY, float moveSpeed) {
+        if (count == x.size()) {
+            for (Column* column : {&x, &y, &targetX, &targetY, &speed}) {
+                column->resize(count + LANES, 0.0f);
+            }
+        }
+        x[count] = posX;
+        y[count] = posY;
+        targetX[count] = destX;
+        targetY[count] = destY;
+        speed[count] = moveSpeed;
+        ++count;
+    }
+
+    /**
+     * @brief Moves every entry speed * deltaTime * timeScale toward its target.
+     *
+     * Entries whose target is within that distance snap onto it and set
+     * their bit in the arrival mask.
+     */
+    void advance(float deltaTime, float timeScale);
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    float getX(size_t index) const { return x[index]; }
+    float getY(size_t index) const { return y[index]; }
+
+    bool arrived(size_t index) const {
+        return (arrivals[index / 64] >> (index % 64)) & 1;
+    }
+
+    /**
+     * @brief One bit per entry, 64 entries per word, set for entries that arrived.
+     */
+    const std::vector<std::uint64_t>& getArrivals() const { return arrivals; }
+
+    /**
+     * @brief Name of the kernel advance() uses on this CPU: "avx2", "sse2" or "scalar".
+     */
+    static const char* getKernelName();
+
+private:
+    template<typename T>
+    struct AlignedAllocator {
+        using value_type = T;
+        static constexpr std::align_val_t ALIGNMENT{32};
+
+        AlignedAllocator() = default;
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U>&) {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), ALIGNMENT));
+        }
+        void deallocate(T* p, size_t) {
+            ::operator delete(p, ALIGNMENT);
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U>&) const { return true; }
+    };
+
+    using Column = std::vector<float, AlignedAllocator<float>>;
+
+    Column x;
+    Column y;
+    Column targetX;
+    Column targetY;
+    Column speed;
+    std::vector<std::uint64_t> arrivals;
+    size_t count = 0; // Live entries; the columns hold count rounded up to LANES
+};
@@ -1,61 +1,254 @@
 #include "MovementManager.h"
-#include "PositionManager.h"
+#include "../SpatialHash.h"
+#include <algorithm>
+#include <cassert>
+
+void MovementManager::update(float deltaTime, float timeScale) {
+    syncPhaseSets();
+#ifndef NDEBUG
+    checkPhaseSets();
+#endif
+    compactPhaseSet(MovementPhase::PLANNING);
+    compactPhaseSet(MovementPhase::ARRIVING);
+    compactPhaseSet(MovementPhase::MOVING);
+    pendingChanges.clear();
+    misfiled.clear();
+
+    // Timed phases only ever return to IDLE here, so none of the sets
+    // being walked gains members until the frame's changes are applied
+    updateTimers(MovementPhase::PLANNING, deltaTime * timeScale);
+    updateTimers(MovementPhase::ARRIVING, deltaTime * timeScale);
+
+    const size_t moving = phaseSet(MovementPhase::MOVING).slots.size();
+    for (size_t begin = 0; begin < moving; begin += CHUNK_SIZE) {
+        updateChunk(begin, std::min(begin + CHUNK_SIZE, moving), deltaTime, timeScale);
+    }
+
+    auto& components = world.getAllComponents<Movement>().getComponents();
+    for (std::uint32_t slot : misfiled) {
+        refile(slot, components[slot].phase);
+    }
+
+    // Emit in storage order, as a pass over every entity would have
+    std::sort(pendingChanges.begin(), pendingChanges.end(),
+              [](const PendingPhaseChange& a, const PendingPhaseChange& b) { return a.slot < b.slot; });
+    for (const PendingPhaseChange& pending : pendingChanges) {
+        const MovementPhaseChanged& change = pending.change;
+        if (change.from == MovementPhase::MOVING && change.to == MovementPhase::ARRIVING) {
+            const PositionComponent& pos = *positionOf[pending.slot];
+            world.events().emit(MovementArrived{change.entity, pos.x, pos.y});
+        }
+        finishPhaseChange(change);
+        refile(pending.slot, change.to);
+    }
+
+    // Idle is never walked, so only merge it once its backlog is as big as it is
+    PhaseSet& idle = phaseSet(MovementPhase::IDLE);
+    if (idle.stale + idle.joining.size() > idle.slots.size()) {
+        compactPhaseSet(MovementPhase::IDLE);
+    }
+}
+
+void MovementManager::syncPhaseSets() {
+    auto& movements = world.getAllComponents<Movement>();
+    auto& positions = world.getAllComponents<PositionComponent>();
+    if (movements.getVersion() != cachedMovementVersion || positions.getVersion() != cachedPositionVersion) {
+        rebuildPhaseSets();
+        return;
+    }
+
+    // Our own changes show up here too; refiling them again is a no-op
+    ECS::ChangeTick since = world.beginChangeRead(lastChangeRead);
+    changedEntities.clear();
+    movements.collectChanged(since, changedEntities);
+    const Movement* first = movements.getComponents().data();
+    for (ECS::EntityID entity : changedEntities) {
+        if (const Movement* movement = movements.getComponent(entity)) {
+            refile(static_cast<std::uint32_t>(movement - first), movement->phase);
+        }
+    }
+}
+
+void MovementManager::rebuildPhaseSets() {
+    auto& movements = world.getAllComponents<Movement>();
+    auto& positions = world.getAllComponents<PositionComponent>();
+
+    // The rescan covers every change logged so far
+    world.beginChangeRead(lastChangeRead);
+
+    const auto& entities = movements.getEntities();
+    const auto& components = movements.getComponents();
+    positionOf.resize(entities.size());
+    membership.resize(entities.size());
+    for (PhaseSet& set : phaseSets) {
+        set.slots.clear();
+        set.entities.clear();
+        set.joining.clear();
+        set.stale = 0;
+    }
+    for (size_t slot = 0; slot < entities.size(); ++slot) {
+        positionOf[slot] = positions.getComponent(entities[slot]);
+        PhaseSet& set = phaseSet(components[slot].phase);
+        membership[slot] = {components[slot].phase, static_cast<std::uint32_t>(set.slots.size())};
+        set.slots.push_back(static_cast<std::uint32_t>(slot));
+        set.entities.push_back(entities[slot]);
+    }
+    cachedMovementVersion = movements.getVersion();
+    cachedPositionVersion = positions.getVersion();
+}
+
+void MovementManager::checkPhaseSets() const {
+    // A mismatch means a phase was assigned without setPhase(); an idle slot
+    // filed that way would never be visited again
+    const auto& components = world.getAllComponents<Movement>().getComponents();
+    for (size_t slot = 0; slot < components.size(); ++slot) {
+        assert(membership[slot].phase == components[slot].phase && "Movement phase changed without setPhase()");
+    }
+}
+
+void MovementManager::refile(std::uint32_t slot, MovementPhase phase) {
+    Membership& member = membership[slot];
+    if (member.phase == phase) {
+        return;
+    }
+
+    // A joining slot that leaves again is dropped by the membership check
+    if (member.index != JOINING) {
+        ++phaseSet(member.phase).stale;
+    }
+    phaseSet(phase).joining.push_back(slot);
+    member = {phase, JOINING};
+}
+
+void MovementManager::compactPhaseSet(MovementPhase phase) {
+    PhaseSet& set = phaseSet(phase);
+    if (set.stale == 0 && set.joining.empty()) {
+        return;
+    }
+
+    // Keep the entries still filed here, in order
+    size_t kept = 0;
+    for (size_t i = 0; i < set.slots.size(); ++i) {
+        const Membership& member = membership[set.slots[i]];
+        if (member.phase == phase && member.index == i) {
+            set.slots[kept] = set.slots[i];
+            set.entities[kept] = set.entities[i];
+            ++kept;
+        }
+    }
+
+    // A slot may have joined more than once, or joined and left again
+    std::sort(set.joining.begin(), set.joining.end());
+    set.joining.erase(std::unique(set.joining.begin(), set.joining.end()), set.joining.end());
+    std::erase_if(set.joining, [&](std::uint32_t slot) {
+        return membership[slot].phase != phase || membership[slot].index != JOINING;
+    });
+
+    // Merge from the back so neither list needs a scratch copy
+    const auto& entities = world.getAllComponents<Movement>().getEntities();
+    size_t from = kept;
+    size_t join = set.joining.size();
+    size_t to = kept + join;
+    set.slots.resize(to);
+    set.entities.resize(to);
+    while (join > 0) {
+        --to;
+        if (from > 0 && set.slots[from - 1] > set.joining[join - 1]) {
+            --from;
+            set.slots[to] = set.slots[from];
+            set.entities[to] = set.entities[from];
+        } else {
+            --join;
+            set.slots[to] = set.joining[join];
+            set.entities[to] = entities[set.joining[join]];
+        }
+    }
+    for (std::uint32_t index = 0; index < set.slots.size(); ++index) {
+        membership[set.slots[index]].index = index;
+    }
+    set.joining.clear();
+    set.stale = 0;
+}
+
+void MovementManager::updateTimers(MovementPhase phase, float elapsed) {
+    auto& movements = world.getAllComponents<Movement>();
+    const auto& entities = movements.getEntities();
+    auto& components = movements.getComponents();
+
+    for (std::uint32_t slot : phaseSet(phase).slots) {
+        if (!positionOf[slot]) {
+            continue;
+        }
+        Movement& movement = components[slot];
+        if (movement.phase != phase) {
+            misfiled.push_back(slot);
+            continue;
+        }
 
-void MovementManager::update(PositionManager& posManager, float deltaTime, float timeScale) {
-    for (auto& [uid, movement] : movements) {
         // Update phase timer (scales with time)
-        movement->phaseTimer += deltaTime * timeScale;
-        
-        // Handle phase transitions
-        switch (movement->phase) {
-            case MovementPhase::PLANNING:
-                if (movement->phaseTimer >= movement->planningDuration) {
-                    movement->phase = MovementPhase::IDLE;
-                    movement->phaseTimer = 0.0f;
-                }
-                break;
-                
-            case MovementPhase::ARRIVING:
-                if (movement->phaseTimer >= movement->arrivingDuration) {
-                    movement->phase = MovementPhase::IDLE;
-                    movement->phaseTimer = 0.0f;
-                }
-                break;
-                
-            case MovementPhase::MOVING:
-                updateMovement(uid, movement.get(), posManager, deltaTime, timeScale);
-                break;
-                
-            case MovementPhase::IDLE:
-                // Entity is idle, no movement updates needed
-                break;
-        }
-    }
-}
-
-void MovementManager::updateMovement(unsigned int uid, Movement* movement, PositionManager& posManager, 
-                                    float deltaTime, float timeScale) {
-    auto* pos = posManager.get(uid);
-    if (!pos) return;
-
-    float dx = movement->targetX - pos->x;
-    float dy = movement->targetY - pos->y;
-    float distance = std::sqrt(dx * dx + dy * dy);
-
-    // Calculate how far we should move in this single frame (scaled by time)
-    float moveDistance = movement->speed * deltaTime * timeScale;
-
-    // If the remaining distance is less than this frame's movement,
-    // snap to the target and transition to arriving phase.
-    if (distance <= moveDistance) {
-        pos->x = movement->targetX;
-        pos->y = movement->targetY;
-        movement->isMoving = false;
-        movement->phase = MovementPhase::ARRIVING;
-        movement->phaseTimer = 0.0f;
-    } else {
-        // Otherwise, move towards the target by the calculated distance
-        pos->x += (dx / distance) * moveDistance;
-        pos->y += (dy / distance) * moveDistance;
+        movement.phaseTimer += elapsed;
+        float duration = phase == MovementPhase::PLANNING ? movement.planningDuration : movement.arrivingDuration;
+        if (movement.phaseTimer >= duration) {
+            movement.phase = MovementPhase::IDLE;
+            movement.phaseTimer = 0.0f;
+            pendingChanges.push_back({slot, {entities[slot], phase, MovementPhase::IDLE}});
+        }
+    }
+}
+
+void MovementManager::updateChunk(size_t begin, size_t end, float deltaTime, float timeScale) {
+    auto& movements = world.getAllComponents<Movement>();
+    const auto& entities = movements.getEntities();
+    auto& components = movements.getComponents();
+    const auto& slots = phaseSet(MovementPhase::MOVING).slots;
+
+    batch.clear();
+    movers.clear();
+
+    for (size_t i = begin; i < end; ++i) {
+        std::uint32_t slot = slots[i];
+        PositionComponent* pos = positionOf[slot];
+        if (!pos) {
+            continue;
+        }
+        Movement& movement = components[slot];
+        if (movement.phase != MovementPhase::MOVING) {
+            misfiled.push_back(slot);
+            continue;
+        }
+
+        movement.phaseTimer += deltaTime * timeScale;
+        movers.push_back(slot);
+        batch.push(pos->x, pos->y, movement.targetX, movement.targetY, movement.speed);
+    }
+
+    batch.advance(deltaTime, timeScale);
+
+    for (size_t i = 0; i < movers.size(); ++i) {
+        std::uint32_t slot = movers[i];
+        applyMove(slot, entities[slot], components[slot], *positionOf[slot], i);
+    }
+}
+
+void MovementManager::finishPhaseChange(const MovementPhaseChanged& change) {
+    world.markChanged<Movement>(change.entity);
+    world.events().emit(change);
+}
+
+void MovementManager::applyMove(std::uint32_t slot, ECS::EntityID entity, Movement& movement,
+                                PositionComponent& pos, size_t index) {
+    pos.x = batch.getX(index);
+    pos.y = batch.getY(index);
+
+    // Reaching the target moves on to the arriving phase
+    if (batch.arrived(index)) {
+        movement.isMoving = false;
+        movement.phase = MovementPhase::ARRIVING;
+        movement.phaseTimer = 0.0f;
+        pendingChanges.push_back({slot, {entity, MovementPhase::MOVING, MovementPhase::ARRIVING}});
+    }
+
+    if (spatialIndex) {
+        spatialIndex->update(entity, pos.x, pos.y);
     }
 }
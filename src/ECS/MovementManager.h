@@ -1,57 +1,183 @@
 #pragma once
-#include <unordered_map>
-#include <memory>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <span>
 #include <vector>
-#include "IComponentManager.h"
+#include "World.h"
+#include "MovementBatch.h"
 #include "./components/Movement.h"
+#include "./components/PositionComponent.h"
+#include "./events/MovementEvents.h"
 
 // Forward declaration to break circular dependency
-class PositionManager;
+class SpatialHash;
 
-class MovementManager : public IComponentManager {
+/**
+ * @brief Advances Movement components stored in an ECS::World.
+ *
+ * Every Movement slot is filed in a dense set for its phase, so a frame
+ * only visits PLANNING, ARRIVING and MOVING entities and idle ones cost
+ * nothing. The sets are kept in Movement storage order, which keeps the
+ * component and spatial index accesses close to sequential. The timed
+ * phases are stepped first; MOVING entities are then gathered a chunk at
+ * a time into a MovementBatch, advanced by a vectorized kernel and
+ * written back. Phase changes are held until the end of the frame and
+ * emitted in storage order, so events come out exactly as a loop over
+ * all entities would emit them. Each slot's PositionComponent pointer is
+ * cached until either storage's version changes, so a frame does no
+ * sparse lookups.
+ *
+ * The sets follow phase changes made elsewhere through the world's
+ * change log, so code outside update() changes phases only through
+ * setPhase() or setTarget(), which mark the Movement changed. Debug
+ * builds check every slot's set against its phase at the start of
+ * update(). Adding or removing Movement or PositionComponent refiles
+ * everything.
+ *
+ * Movement is marked changed in the world only when its phase changes,
+ * and each change it makes is emitted on the world's EventBus as a
+ * MovementPhaseChanged event (plus MovementArrived on reaching a target).
+ */
+class MovementManager {
 public:
-    std::unordered_map<unsigned int, std::unique_ptr<Movement>> movements;
+    explicit MovementManager(ECS::World& world) : world(world) {}
 
-    Movement* create(unsigned int entityUID, float speed) {
-        auto move = std::make_unique<Movement>(speed);
-        Movement* ptr = move.get();
-        movements[entityUID] = std::move(move);
-        return ptr;
+    Movement* create(ECS::EntityID entity, float speed) {
+        return world.addComponent<Movement>(entity, speed);
     }
 
-    Movement* get(unsigned int entityUID) {
-        auto it = movements.find(entityUID);
-        return (it != movements.end()) ? it->second.get() : nullptr;
+    Movement* get(ECS::EntityID entity) {
+        return world.getComponent<Movement>(entity);
     }
 
-    void update(PositionManager& posManager, float deltaTime, float timeScale = 1.0f);
+    void update(float deltaTime, float timeScale = 1.0f);
+
+    /**
+     * @brief Puts movement in phase with a fresh timer and marks it changed in world.
+     *
+     * The one way to change a phase outside update(); isMoving follows
+     * the phase. Emits nothing, so callers that announce phase changes
+     * emit their own MovementPhaseChanged.
+     * @return bool False if movement was already in phase.
+     */
+    static bool setPhase(ECS::World& world, ECS::EntityID entity, Movement& movement, MovementPhase phase) {
+        if (movement.phase == phase) {
+            return false;
+        }
+        movement.phase = phase;
+        movement.phaseTimer = 0.0f;
+        movement.isMoving = phase == MovementPhase::MOVING;
+        world.markChanged<Movement>(entity);
+        return true;
+    }
+
+    /**
+     * @brief Aims movement at (x, y) and puts it in the MOVING phase.
+     */
+    static void setTarget(ECS::World& world, ECS::EntityID entity, Movement& movement, float x, float y) {
+        movement.targetX = x;
+        movement.targetY = y;
+        setPhase(world, entity, movement, MovementPhase::MOVING);
+        movement.phaseTimer = 0.0f; // A new target restarts the timer even mid-move
+    }
+
+    /**
+     * @brief Sets the spatial index that is kept in sync as entities move.
+     */
+    void setSpatialIndex(SpatialHash* index) { spatialIndex = index; }
     
 private:
-    void updateMovement(unsigned int uid, Movement* movement, PositionManager& posManager, 
-                       float deltaTime, float timeScale = 1.0f);
+    static constexpr size_t CHUNK_SIZE = 256; // Entities per kernel call
+    static constexpr size_t PHASE_COUNT = 4;
+    static constexpr std::uint32_t JOINING = UINT32_MAX; // Membership index of a slot not merged in yet
+
+    /**
+     * @brief Movement slots in one phase, in storage order, and their entities.
+     *
+     * Slots that leave stay behind as stale entries and slots that join
+     * wait in joining; compactPhaseSet() drops the one and merges in the
+     * other in a single linear pass.
+     */
+    struct PhaseSet {
+        std::vector<std::uint32_t> slots;
+        std::vector<ECS::EntityID> entities;
+        std::vector<std::uint32_t> joining;
+        size_t stale = 0;
+    };
+
+    /**
+     * @brief The set a Movement slot is filed in and its index there, or JOINING.
+     */
+    struct Membership {
+        MovementPhase phase;
+        std::uint32_t index;
+    };
+
+    /**
+     * @brief A phase change made this frame, emitted once the frame's moves are written back.
+     */
+    struct PendingPhaseChange {
+        std::uint32_t slot;
+        MovementPhaseChanged change;
+    };
+
+    ECS::World& world;
+    SpatialHash* spatialIndex = nullptr;
+
+    // PositionComponent of each Movement slot (null if it has none) and the
+    // phase sets, valid while neither storage's version changes
+    std::vector<PositionComponent*> positionOf;
+    std::vector<Membership> membership;
+    std::array<PhaseSet, PHASE_COUNT> phaseSets;
+    std::uint64_t cachedMovementVersion = UINT64_MAX;
+    std::uint64_t cachedPositionVersion = UINT64_MAX;
+    ECS::ChangeTick lastChangeRead = 0;
+
+    // Reused every frame so a steady frame does not allocate
+    MovementBatch batch;
+    std::vector<std::uint32_t> movers; // Movement slot of each batch entry
+    std::vector<PendingPhaseChange> pendingChanges;
+    std::vector<std::uint32_t> misfiled; // Slots whose phase changed without a mark
+    std::vector<ECS::EntityID> changedEntities;
+
+    PhaseSet& phaseSet(MovementPhase phase) { return phaseSets[static_cast<size_t>(phase)]; }
+
+    /**
+     * @brief Brings the position cache and phase sets up to date with the world.
+     */
+    void syncPhaseSets();
+    void rebuildPhaseSets();
+    void checkPhaseSets() const;
+    void refile(std::uint32_t slot, MovementPhase phase);
+
+    /**
+     * @brief Drops a set's stale entries and merges in its joining slots.
+     */
+    void compactPhaseSet(MovementPhase phase);
+    void updateTimers(MovementPhase phase, float elapsed);
+    void updateChunk(size_t begin, size_t end, float deltaTime, float timeScale);
+    void finishPhaseChange(const MovementPhaseChanged& change);
+    void applyMove(std::uint32_t slot, ECS::EntityID entity, Movement& movement, PositionComponent& pos, size_t index);
     
 public:
     /**
-     * @brief Gets all entities in a specific movement phase.
+     * @brief Gets all entities in a specific movement phase, in storage order.
+     *
+     * The span views the manager's own set and does not allocate. It is
+     * valid until the next call to update() or getEntitiesInPhase().
      */
-    std::vector<unsigned int> getEntitiesInPhase(MovementPhase phase) {
-        std::vector<unsigned int> entities;
-        for (const auto& [uid, movement] : movements) {
-            if (movement->phase == phase) {
-                entities.push_back(uid);
-            }
-        }
-        return entities;
+    std::span<const ECS::EntityID> getEntitiesInPhase(MovementPhase phase) {
+        syncPhaseSets();
+        compactPhaseSet(phase);
+        return phaseSet(phase).entities;
     }
     
     /**
      * @brief Checks if an entity can accept new movement commands.
      */
-    bool canEntityMove(unsigned int entityUID) {
-        auto* movement = get(entityUID);
+    bool canEntityMove(ECS::EntityID entity) {
+        auto* movement = get(entity);
         return movement ? movement->canAcceptNewTarget() : true;
     }
-
-    void dump() override {}
-};
\ No newline at end of file
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Occupancy report for a pool or component storage.
+     */
+    struct PoolStats {
+        size_t live = 0;          // Objects currently allocated
+        size_t capacity = 0;      // Slots reserved across all slabs
+        size_t slabs = 0;         // Slabs (or pages) currently allocated
+        size_t bytesReserved = 0; // Memory held, including free slots
+        size_t strandedSlots = 0; // Slots in partly used slabs that a compact layout would not need
+
+        double occupancy() const {
+            return capacity ? static_cast<double>(live) / capacity : 0.0;
+        }
+
+        /**
+         * @brief Share of reserved slots pinned only because live objects are scattered.
+         *
+         * Zero when the live objects would not fit in fewer slabs.
+         */
+        double fragmentation() const {
+            return capacity ? static_cast<double>(strandedSlots) / capacity : 0.0;
+        }
+
+        PoolStats& operator+=(const PoolStats& other) {
+            live += other.live;
+            capacity += other.capacity;
+            slabs += other.slabs;
+            bytesReserved += other.bytesReserved;
+            strandedSlots += other.strandedSlots;
+            return *this;
+        }
+    };
+
+    inline void writePoolStats(std::ostream& out, const char* label, const PoolStats& stats) {
+        out << label << ": " << stats.live << "/" << stats.capacity << " live"
+            << " (" << stats.occupancy() * 100.0 << "% occupancy, "
+            << stats.fragmentation() * 100.0 << "% fragmentation), "
+            << stats.slabs << " slabs, " << stats.bytesReserved << " bytes\n";
+    }
+
+    /**
+     * @brief Deleter that hands an object back to the pool it came from.
+     *
+     * Holds a type-erased pool pointer so one unique_ptr<Base> type can
+     * own objects from pools of different derived types.
+     */
+    template<typename T>
+    class PoolDeleter {
+    public:
+        PoolDeleter() = default;
+        PoolDeleter(void* pool, void (*release)(void*, T*)) : pool(pool), release(release) {}
+
+        void operator()(T* object) const { release(pool, object); }
+
+    private:
+        void* pool = nullptr;
+        void (*release)(void*, T*) = nullptr;
+    };
+
+    template<typename T>
+    using PoolPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+    /**
+     * @brief Typed slab allocator with stable addresses.
+     *
+     * Objects live in fixed-size slabs of SlabSize slots. Freed slots go on
+     * an intrusive free list and are reused before any new slab is
+     * allocated, so steady spawn/despawn churn stops hitting the heap once
+     * the pool has grown to its peak. Objects never move. Not thread-safe.
+     */
+    template<typename T, size_t SlabSize = 256>
+    class ObjectPool {
+    public:
+        ObjectPool() = default;
+
+        ~ObjectPool() {
+            assert(live == 0 && "objects outlived their pool");
+        }
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /**
+         * @brief Constructs an object in a free slot.
+         */
+        template<typename... Args>
+        T* create(Args&&... args) {
+            if (!freeHead) {
+                addSlab();
+            }
+            Slot* slot = freeHead;
+            freeHead = slot->nextFree;
+
+            T* object = new (slot->storage) T(std::forward<Args>(args)...);
+            ++slabs[slot->slab].live;
+            ++live;
+            return object;
+        }
+
+        /**
+         * @brief Destroys an object created by this pool and frees its slot.
+         */
+        void destroy(T* object) {
+            Slot* slot = reinterpret_cast<Slot*>(object);
+            object->~T();
+            --slabs[slot->slab].live;
+            --live;
+            slot->nextFree = freeHead;
+            freeHead = slot;
+        }
+
+        /**
+         * @brief Creates an object owned by a unique_ptr that returns it to this pool.
+         */
+        template<typename... Args>
+        PoolPtr<T> makeUnique(Args&&... args) {
+            return makeUniqueAs<T>(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief As makeUnique(), but owned through a pointer to the base class Base.
+         */
+        template<typename Base, typename... Args>
+        PoolPtr<Base> makeUniqueAs(Args&&... args) {
+            T* object = create(std::forward<Args>(args)...);
+            return PoolPtr<Base>(object, PoolDeleter<Base>(this, [](void* pool, Base* base) {
+                static_cast<ObjectPool*>(pool)->destroy(static_cast<T*>(base));
+            }));
+        }
+
+        /**
+         * @brief Frees every slab with no live objects.
+         */
+        void trim() {
+            // Unlink free slots of empty slabs first, while their memory is still valid
+            Slot* kept = nullptr;
+            Slot** tail = &kept;
+            for (Slot* slot = freeHead; slot;) {
+                Slot* next = slot->nextFree;
+                if (slabs[slot->slab].live > 0) {
+                    *tail = slot;
+                    tail = &slot->nextFree;
+                }
+                slot = next;
+            }
+            *tail = nullptr;
+            freeHead = kept;
+
+            for (Slab& slab : slabs) {
+                if (slab.live == 0) {
+                    slab.slots.reset();
+                }
+            }
+        }
+
+        size_t size() const { return live; }
+
+        PoolStats getStats() const {
+            PoolStats stats;
+            stats.live = live;
+            size_t slabsInUse = 0;
+            for (const Slab& slab : slabs) {
+                if (!slab.slots) {
+                    continue;
+                }
+                ++stats.slabs;
+                stats.capacity += SlabSize;
+                slabsInUse += slab.live > 0 ? 1 : 0;
+            }
+            size_t slabsNeeded = (live + SlabSize - 1) / SlabSize;
+            stats.strandedSlots = (slabsInUse - slabsNeeded) * SlabSize;
+            stats.bytesReserved = stats.slabs * SlabSize * sizeof(Slot);
+            return stats;
+        }
+
+    private:
+        struct Slot {
+            union {
+                alignas(T) std::byte storage[sizeof(T)];
+                Slot* nextFree;
+            };
+            std::uint32_t slab;
+        };
+
+        struct Slab {
+            std::unique_ptr<Slot[]> slots;
+            size_t live = 0;
+        };
+
+        std::vector<Slab> slabs; // Released slabs stay as empty entries so indices hold
+        Slot* freeHead = nullptr;
+        size_t live = 0;
+
+        void addSlab() {
+            size_t index = 0;
+            while (index < slabs.size() && slabs[index].slots) {
+                ++index;
+            }
+            if (index == slabs.size()) {
+                slabs.emplace_back();
+            }
+
+            Slab& slab = slabs[index];
+            slab.slots = std::make_unique<Slot[]>(SlabSize);
+            // Link back to front so slots are handed out in address order
+            for (size_t i = SlabSize; i-- > 0;) {
+                slab.slots[i].slab = static_cast<std::uint32_t>(index);
+                slab.slots[i].nextFree = freeHead;
+                freeHead = &slab.slots[i];
+            }
+        }
+    };
+}
@@ -1 +0,0 @@
-#include "PositionManager.h"
\ No newline at end of file
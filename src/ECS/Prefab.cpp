@@ -0,0 +1,32 @@
+#include "Prefab.h"
+
+namespace ECS {
+
+    EntityID Prefab::instantiate(World& world) const {
+        EntityID entityID = world.createEntity();
+        if (!isValidEntity(entityID)) {
+            return INVALID_ENTITY; // The entity index space is used up
+        }
+        world.getEntityManager().addTags(entityID, tags);
+        for (const auto& [typeID, entry] : components) {
+            entry->addTo(world, std::span<const EntityID>(&entityID, 1));
+        }
+        return entityID;
+    }
+
+    size_t Prefab::spawnBatch(World& world, size_t count, std::vector<EntityID>& out) const {
+        size_t first = out.size();
+        count = world.createEntities(count, out);
+        std::span<const EntityID> spawned(out.data() + first, count);
+        if (tags != 0) {
+            EntityManager& entityManager = world.getEntityManager();
+            for (EntityID entityID : spawned) {
+                entityManager.addTags(entityID, tags);
+            }
+        }
+        for (const auto& [typeID, entry] : components) {
+            entry->addTo(world, spawned);
+        }
+        return count;
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "World.h"
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Named set of component values that new entities start with.
+     *
+     * A prefab holds one template value per component type. instantiate()
+     * creates a single entity with a copy of each; spawnBatch() creates many
+     * at once, walking the prefab one component type at a time so each
+     * storage is reserved once and then filled in a tight loop instead of
+     * hopping between storages per entity. Templates are shared between
+     * copies of a prefab, so copying one to derive a variant is cheap;
+     * set() on the copy replaces only that copy's template.
+     */
+    class Prefab {
+    public:
+        /**
+         * @brief Adds or replaces the template for ComponentType.
+         */
+        template<typename ComponentType>
+        Prefab& set(ComponentType component) {
+            auto entry = std::make_shared<const ComponentTemplate<ComponentType>>(std::move(component));
+            ComponentTypeID typeID = componentTypeID<ComponentType>();
+            for (auto& [id, existing] : components) {
+                if (id == typeID) {
+                    existing = std::move(entry);
+                    return *this;
+                }
+            }
+            components.emplace_back(typeID, std::move(entry));
+            return *this;
+        }
+
+        /**
+         * @brief Adds tags that every entity made from this prefab carries.
+         */
+        template<typename... Tags>
+        Prefab& tag() {
+            tags |= tagMask<Tags...>();
+            return *this;
+        }
+
+        TagMask getTags() const { return tags; }
+
+        template<typename ComponentType>
+        void remove() {
+            ComponentTypeID typeID = componentTypeID<ComponentType>();
+            std::erase_if(components, [typeID](const auto& component) { return component.first == typeID; });
+        }
+
+        /**
+         * @brief Template value for ComponentType, or null if the prefab has none.
+         */
+        template<typename ComponentType>
+        const ComponentType* get() const {
+            ComponentTypeID typeID = componentTypeID<ComponentType>();
+            for (const auto& [id, entry] : components) {
+                if (id == typeID) {
+                    return &static_cast<const ComponentTemplate<ComponentType>&>(*entry).value;
+                }
+            }
+            return nullptr;
+        }
+
+        template<typename ComponentType>
+        bool has() const { return get<ComponentType>() != nullptr; }
+
+        size_t componentCount() const { return components.size(); }
+
+        /**
+         * @brief Creates one entity with a copy of every template.
+         * @return EntityID The new entity, or INVALID_ENTITY once the index space is used up.
+         */
+        EntityID instantiate(World& world) const;
+
+        /**
+         * @brief Creates count entities with copies of every template and appends them to out.
+         *
+         * New entities are appended in creation order, and with the
+         * sparse-set backend their components land at the end of each dense
+         * array in that same order. If the entity index space runs out the
+         * batch is cut short rather than filled with INVALID_ENTITY.
+         * @return size_t How many entities were spawned.
+         */
+        size_t spawnBatch(World& world, size_t count, std::vector<EntityID>& out) const;
+
+    private:
+        struct IComponentTemplate {
+            virtual ~IComponentTemplate() = default;
+            virtual void addTo(World& world, std::span<const EntityID> entities) const = 0;
+        };
+
+        template<typename ComponentType>
+        struct ComponentTemplate final : IComponentTemplate {
+            ComponentType value;
+
+            explicit ComponentTemplate(ComponentType value) : value(std::move(value)) {}
+
+            void addTo(World& world, std::span<const EntityID> entities) const override {
+                // Single adds (instantiate) are not worth skipping the liveness check for
+                if (entities.size() == 1 || world.getStorageBackend() == World::StorageBackend::Archetype) {
+                    for (EntityID entityID : entities) {
+                        world.addComponent<ComponentType>(entityID, value);
+                    }
+                    return;
+                }
+                // Entities come straight from the entity manager, so skip the per-add liveness check
+                auto& storage = world.getAllComponents<ComponentType>();
+                storage.reserveExtra(entities.size());
+                for (EntityID entityID : entities) {
+                    assert(world.isEntityAlive(entityID) && "Prefab batch holds a dead entity");
+                    storage.addComponent(entityID, value);
+                }
+            }
+        };
+
+        std::vector<std::pair<ComponentTypeID, std::shared_ptr<const IComponentTemplate>>> components;
+        TagMask tags = 0;
+    };
+}
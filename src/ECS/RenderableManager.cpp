@@ -1,18 +1,20 @@
 #include "RenderableManager.h"
-#include "PositionManager.h"
+#include "../Camera.h"
 #include <iostream>
 
-void RenderableManager::renderAll(SDL_Renderer* ren, PositionManager& positionManager) const {
-    for (const auto& [uid, r] : renderables) {
-        if (r) {
-            auto pos = positionManager.get(uid);
-            if (pos) {
-                r->rect.x = pos->x - (r->rect.w / 2);
-                r->rect.y = pos->y - (r->rect.h / 2);
-            }
-            r->render(ren);
-        }
+void RenderableManager::renderAll(SDL_Renderer* ren, const std::vector<RenderSnapshot::EntityView>& entities,
+                                  const Camera& camera) const {
+    camera.beginWorld(ren);
+    for (const auto& entity : entities) {
+        auto it = renderables.find(entity.uid);
+        if (it == renderables.end() || !it->second) continue;
+
+        const auto& r = it->second;
+        r->rect.x = entity.x - (r->rect.w / 2) - camera.getX();
+        r->rect.y = entity.y - (r->rect.h / 2) - camera.getY();
+        r->render(ren);
     }
+    camera.endWorld(ren);
 }
 
 void RenderableManager::dump() {
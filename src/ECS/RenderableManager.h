@@ -3,37 +3,56 @@
 #include <unordered_map>
 #include <memory>
 #include "./IComponentManager.h"
+#include "ObjectPool.h"
 #include "./components/IRenderable.h"
 #include "./components/Square.h"
 #include "./components/Circle.h"
 #include "Entity.h"
 
+#include "../RenderSnapshot.h"
+
 // Forward declaration to break circular dependency
-class PositionManager;
+class Camera;
 
 
 class RenderableManager : public IComponentManager {
+private:
+    // One pool per concrete shape; declared before the map so they outlive it
+    ECS::ObjectPool<Square> squarePool;
+    ECS::ObjectPool<Circle> circlePool;
+
 public:
     // Map from Entity UID to IRenderable component
-    std::unordered_map<unsigned int, std::unique_ptr<IRenderable>> renderables;
+    std::unordered_map<unsigned int, ECS::PoolPtr<IRenderable>> renderables;
 
     // Factory method for quads
     Square* createQuad(unsigned int entityUID, float x, float y, SDL_Color color) {
-        auto square = std::make_unique<Square>(x, y, 32, color);
-        Square* ptr = square.get();
+        auto square = squarePool.makeUniqueAs<IRenderable>(x, y, 32, color);
+        Square* ptr = static_cast<Square*>(square.get());
         renderables[entityUID] = std::move(square);
         return ptr;
     }
 
     // Factory method for circles
     Circle* createCircle(unsigned int entityUID, float x, float y, SDL_Color color) {
-        auto circle = std::make_unique<Circle>(x, y, 16, color);
-        Circle* ptr = circle.get();
+        auto circle = circlePool.makeUniqueAs<IRenderable>(x, y, 16, color);
+        Circle* ptr = static_cast<Circle*>(circle.get());
         renderables[entityUID] = std::move(circle);
         return ptr;
     }
 
-    void renderAll(SDL_Renderer* ren, PositionManager& positionManager) const;
+    /**
+     * @brief Renders the entities captured in a simulation snapshot.
+     * @param entities Visible entity positions, already culled by the simulation.
+     */
+    void renderAll(SDL_Renderer* ren, const std::vector<RenderSnapshot::EntityView>& entities,
+                   const Camera& camera) const;
+
+    ECS::PoolStats getPoolStats() const {
+        ECS::PoolStats stats = squarePool.getStats();
+        stats += circlePool.getStats();
+        return stats;
+    }
 
     void dump() override;
 
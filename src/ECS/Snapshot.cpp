@@ -0,0 +1,168 @@
+#include "Snapshot.h"
+#include <algorithm>
+#include <fstream>
+
+namespace ECS {
+    
+    bool SnapshotWriter::saveToFile(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        return static_cast<bool>(file);
+    }
+    
+    bool SnapshotReader::loadFromFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        std::streamsize length = file.tellg();
+        file.seekg(0);
+        owned.resize(static_cast<size_t>(length));
+        if (!file.read(reinterpret_cast<char*>(owned.data()), length)) {
+            return false;
+        }
+        data = owned.data();
+        size = owned.size();
+        offset = 0;
+        failed = false;
+        return true;
+    }
+    
+    void WorldSerializer::save(const World& world, SnapshotWriter& writer) const {
+        const EntityManager& entityManager = world.getEntityManager();
+        const auto& slots = entityManager.getSlots();
+        const auto& living = entityManager.getAllEntities();
+        
+        writer.write(FORMAT_VERSION);
+        writer.write(static_cast<std::uint32_t>(slots.size()));
+        writer.write(entityManager.getFreeHead());
+        writer.writeArray(slots.data(), slots.size());
+        writer.write(static_cast<std::uint32_t>(living.size()));
+        writer.writeArray(living.data(), living.size());
+        
+        std::vector<EntityID> tagged;
+        writer.write(static_cast<std::uint32_t>(tags.size()));
+        for (const TagCodec& tag : tags) {
+            tagged.clear();
+            world.forEachTagged(TagQuery{tag.bit, 0}, [&tagged](EntityID entityID) { tagged.push_back(entityID); });
+            writer.writeString(tag.name);
+            writer.write(static_cast<std::uint32_t>(tagged.size()));
+            writer.writeArray(tagged.data(), tagged.size());
+        }
+        
+        writer.write(static_cast<std::uint32_t>(codecs.size()));
+        for (const Codec& codec : codecs) {
+            writer.writeString(codec.name);
+            size_t block = writer.beginBlock();
+            codec.save(world, writer);
+            writer.endBlock(block);
+        }
+    }
+    
+    bool WorldSerializer::load(World& world, SnapshotReader& reader) const {
+        StagedWorld staged;
+        return !world.getArchetypeStorage() && decode(reader, staged) && commit(world, staged);
+    }
+    
+    bool WorldSerializer::decode(SnapshotReader& reader, StagedWorld& staged) const {
+        if (reader.read<std::uint32_t>() != FORMAT_VERSION) {
+            return false;
+        }
+        
+        std::uint32_t slotCount = 0;
+        std::uint32_t freeHead = 0;
+        reader.read(slotCount);
+        reader.read(freeHead);
+        if (!reader.ok() || slotCount > reader.remaining() / sizeof(EntityID)) {
+            return false;
+        }
+        staged.slots.resize(slotCount);
+        staged.freeHead = freeHead;
+        reader.readArray(staged.slots.data(), slotCount);
+        
+        std::uint32_t livingCount = reader.read<std::uint32_t>();
+        if (!reader.ok() || livingCount > reader.remaining() / sizeof(EntityID)) {
+            return false;
+        }
+        staged.living.resize(livingCount);
+        reader.readArray(staged.living.data(), livingCount);
+        
+        // Handles in tag lists and component blocks are checked against the staged manager
+        staged.tagged.clear();
+        staged.blocks.clear();
+        if (!reader.ok() || !staged.entityManager.restore(staged.slots, freeHead, staged.living)) {
+            return false;
+        }
+        
+        std::string name;
+        std::uint32_t tagCount = reader.read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < tagCount && reader.ok(); ++i) {
+            reader.readString(name);
+            std::uint32_t count = reader.read<std::uint32_t>();
+            if (!reader.ok() || count > reader.remaining() / sizeof(EntityID)) {
+                return false;
+            }
+            std::vector<EntityID> tagged(count);
+            reader.readArray(tagged.data(), count);
+            
+            auto tag = std::find_if(tags.begin(), tags.end(),
+                                    [&name](const TagCodec& candidate) { return candidate.name == name; });
+            if (tag == tags.end()) {
+                continue; // Tag unknown to this build
+            }
+            for (EntityID entityID : tagged) {
+                if (!staged.entityManager.isAlive(entityID)) {
+                    return false;
+                }
+            }
+            staged.tagged.emplace_back(tag->bit, std::move(tagged));
+        }
+        
+        std::uint32_t blockCount = reader.read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < blockCount && reader.ok(); ++i) {
+            reader.readString(name);
+            std::uint64_t length = reader.read<std::uint64_t>();
+            if (!reader.ok() || length > reader.remaining()) {
+                return false;
+            }
+            
+            auto codec = std::find_if(codecs.begin(), codecs.end(),
+                                      [&name](const Codec& candidate) { return candidate.name == name; });
+            if (codec == codecs.end()) {
+                reader.skip(static_cast<size_t>(length));
+                continue;
+            }
+            
+            size_t before = reader.remaining();
+            std::unique_ptr<StagedBlock> block = codec->load(staged.entityManager, reader);
+            if (!block || before - reader.remaining() != length) {
+                return false;
+            }
+            staged.blocks.push_back(std::move(block));
+        }
+        return reader.ok();
+    }
+    
+    bool WorldSerializer::commit(World& world, StagedWorld& staged) const {
+        if (world.getArchetypeStorage()) {
+            return false;
+        }
+        
+        // decode() checked everything, so nothing below can fail
+        world.getComponentRegistry().clear();
+        EntityManager& entityManager = world.getEntityManager();
+        entityManager.restore(staged.slots, staged.freeHead, staged.living);
+        for (const auto& [bit, tagged] : staged.tagged) {
+            for (EntityID entityID : tagged) {
+                entityManager.addTags(entityID, bit);
+            }
+        }
+        for (const auto& block : staged.blocks) {
+            block->commit(world);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "World.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Appends binary data to a growable in-memory buffer.
+     *
+     * Values are written in native byte order with no padding between
+     * them. The finished buffer goes to disk with a single write.
+     */
+    class SnapshotWriter {
+    public:
+        template<typename T>
+        void write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "write() copies raw bytes");
+            append(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Writes count values as one contiguous copy.
+         */
+        template<typename T>
+        void writeArray(const T* values, size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>, "writeArray() copies raw bytes");
+            append(values, count * sizeof(T));
+        }
+
+        void writeString(const std::string& value) {
+            write(static_cast<std::uint32_t>(value.size()));
+            append(value.data(), value.size());
+        }
+
+        /**
+         * @brief Reserves a length field for a block; pass the result to endBlock().
+         */
+        size_t beginBlock() {
+            size_t offset = buffer.size();
+            write(std::uint64_t{0});
+            return offset;
+        }
+
+        /**
+         * @brief Fills in the length of everything written since beginBlock().
+         */
+        void endBlock(size_t offset) {
+            std::uint64_t length = buffer.size() - offset - sizeof(std::uint64_t);
+            std::memcpy(buffer.data() + offset, &length, sizeof(length));
+        }
+
+        const std::vector<std::byte>& getData() const { return buffer; }
+        void reserve(size_t bytes) { buffer.reserve(bytes); }
+        void clear() { buffer.clear(); }
+
+        bool saveToFile(const std::string& filename) const;
+
+    private:
+        std::vector<std::byte> buffer;
+
+        void append(const void* data, size_t size) {
+            size_t offset = buffer.size();
+            buffer.resize(offset + size);
+            if (size > 0) {
+                std::memcpy(buffer.data() + offset, data, size);
+            }
+        }
+    };
+
+    /**
+     * @brief Bounds-checked reads from a snapshot held in memory.
+     *
+     * Any read past the end marks the reader failed; later reads then
+     * fail too, so callers can check ok() once after a batch of reads.
+     */
+    class SnapshotReader {
+    public:
+        SnapshotReader() = default;
+        SnapshotReader(const std::byte* data, size_t size) : data(data), size(size) {}
+
+        /**
+         * @brief Reads a whole file into memory in one go.
+         */
+        bool loadFromFile(const std::string& filename);
+
+        template<typename T>
+        bool read(T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "read() copies raw bytes");
+            return take(&value, sizeof(T));
+        }
+
+        template<typename T>
+        T read() {
+            T value{};
+            read(value);
+            return value;
+        }
+
+        template<typename T>
+        bool readArray(T* values, size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>, "readArray() copies raw bytes");
+            return take(values, count * sizeof(T));
+        }
+
+        bool readString(std::string& value) {
+            std::uint32_t length = 0;
+            if (!read(length) || length > remaining()) {
+                failed = true;
+                return false;
+            }
+            value.assign(reinterpret_cast<const char*>(data + offset), length);
+            offset += length;
+            return true;
+        }
+
+        bool skip(size_t bytes) {
+            if (failed || bytes > remaining()) {
+                failed = true;
+                return false;
+            }
+            offset += bytes;
+            return true;
+        }
+
+        size_t remaining() const { return size - offset; }
+        bool ok() const { return !failed; }
+
+    private:
+        std::vector<std::byte> owned; // Backing store when loaded from a file
+        const std::byte* data = nullptr;
+        size_t size = 0;
+        size_t offset = 0;
+        bool failed = false;
+
+        bool take(void* out, size_t bytes) {
+            if (failed || bytes > remaining()) {
+                failed = true;
+                return false;
+            }
+            if (bytes > 0) {
+                std::memcpy(out, data + offset, bytes);
+            }
+            offset += bytes;
+            return true;
+        }
+    };
+
+    /**
+     * @brief Describes how one component type is stored in snapshots.
+     *
+     * Specialize for each saved component with:
+     *   static constexpr const char* name;   // Stable across builds, unlike type IDs
+     *   static void write(SnapshotWriter&, const ComponentType&);
+     *   static ComponentType read(SnapshotReader&);
+     */
+    template<typename ComponentType>
+    struct SnapshotTraits;
+
+    /**
+     * @brief Saves and loads the entities and registered components of a World.
+     *
+     * The entity manager's slot array (generations and free list included)
+     * and living order are written as raw arrays. Each registered component
+     * storage follows as one length-prefixed block: its name, its entity
+     * column as a raw array, then every component in dense order. Loading
+     * therefore restores the same handles, the same free-list order and the
+     * same iteration order, so a loaded world continues exactly as the saved
+     * one would have. Blocks for component types the loader does not know
+     * are skipped. Registered tags are saved by name as lists of entities,
+     * since tag bits depend on first-use order. Requires the sparse-set
+     * backend.
+     */
+    class WorldSerializer {
+    private:
+        /**
+         * @brief One decoded component block, waiting until the whole stream has checked out.
+         */
+        struct StagedBlock {
+            virtual ~StagedBlock() = default;
+            virtual void commit(World& world) = 0;
+        };
+
+        template<typename ComponentType>
+        struct StagedStorage final : StagedBlock {
+            std::vector<EntityID> entities;
+            std::vector<ComponentType> components;
+
+            void commit(World& world) override {
+                world.getAllComponents<ComponentType>().reserve(entities.size());
+                for (size_t i = 0; i < entities.size(); ++i) {
+                    world.addComponent<ComponentType>(entities[i], std::move(components[i]));
+                }
+            }
+        };
+
+    public:
+        static constexpr std::uint32_t FORMAT_VERSION = 2;
+
+        /**
+         * @brief A decoded, fully checked world waiting to replace a live one.
+         */
+        class StagedWorld {
+        private:
+            friend class WorldSerializer;
+            EntityManager entityManager; // Only used to check handles while decoding
+            std::vector<EntityID> slots;
+            std::uint32_t freeHead = 0;
+            std::vector<EntityID> living;
+            std::vector<std::pair<TagMask, std::vector<EntityID>>> tagged;
+            std::vector<std::unique_ptr<StagedBlock>> blocks;
+        };
+
+        template<typename ComponentType>
+        void registerComponent() {
+            codecs.push_back({SnapshotTraits<ComponentType>::name,
+                              &saveStorage<ComponentType>, &loadStorage<ComponentType>});
+        }
+
+        /**
+         * @brief Saves and loads Tag under name, which must stay the same across builds.
+         */
+        template<typename Tag>
+        void registerTag(const char* name) {
+            tags.push_back({name, tagBit<Tag>()});
+        }
+        
+        void save(const World& world, SnapshotWriter& writer) const;
+
+        /**
+         * @brief Replaces every entity and component in world with the saved ones.
+         *
+         * Systems and component types that were not registered are left
+         * out; unregistered components are dropped. Same as decode()
+         * followed by commit(), so a false return leaves world exactly as
+         * it was.
+         * @return bool False if the data is truncated, inconsistent or from another format version.
+         */
+        bool load(World& world, SnapshotReader& reader) const;
+
+        /**
+         * @brief Reads and checks a saved world without touching any live one.
+         *
+         * Lets callers with more state after the world in the same stream
+         * check all of it before committing anything.
+         */
+        bool decode(SnapshotReader& reader, StagedWorld& staged) const;
+
+        /**
+         * @brief Replaces world's entities and components with a decoded world.
+         * @return bool False, leaving world untouched, if it uses the archetype backend.
+         */
+        bool commit(World& world, StagedWorld& staged) const;
+
+    private:
+        struct Codec {
+            std::string name;
+            void (*save)(const World&, SnapshotWriter&);
+            std::unique_ptr<StagedBlock> (*load)(const EntityManager&, SnapshotReader&);
+        };
+
+        struct TagCodec {
+            std::string name;
+            TagMask bit;
+        };
+        
+        std::vector<Codec> codecs;
+        std::vector<TagCodec> tags;
+
+        template<typename ComponentType>
+        static void saveStorage(const World& world, SnapshotWriter& writer) {
+            const auto& storage = world.getAllComponents<ComponentType>();
+            const auto& entities = storage.getEntities();
+            writer.write(static_cast<std::uint32_t>(entities.size()));
+            writer.writeArray(entities.data(), entities.size());
+            for (const ComponentType& component : storage.getComponents()) {
+                SnapshotTraits<ComponentType>::write(writer, component);
+            }
+        }
+
+        /**
+         * @brief Decodes one block, checking its entities against the staged entity manager.
+         * @return Null if the block is truncated, names a dead entity or names one twice.
+         */
+        template<typename ComponentType>
+        static std::unique_ptr<StagedBlock> loadStorage(const EntityManager& entityManager, SnapshotReader& reader) {
+            std::uint32_t count = 0;
+            if (!reader.read(count) || count > reader.remaining() / sizeof(EntityID)) {
+                return nullptr;
+            }
+            auto staged = std::make_unique<StagedStorage<ComponentType>>();
+            staged->entities.resize(count);
+            if (!reader.readArray(staged->entities.data(), count)) {
+                return nullptr;
+            }
+
+            staged->components.reserve(count);
+            for (EntityID entityID : staged->entities) {
+                if (!entityManager.isAlive(entityID)) {
+                    return nullptr;
+                }
+                staged->components.push_back(SnapshotTraits<ComponentType>::read(reader));
+                if (!reader.ok()) {
+                    return nullptr;
+                }
+            }
+
+            std::vector<EntityID> sorted = staged->entities;
+            std::sort(sorted.begin(), sorted.end());
+            if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+                return nullptr;
+            }
+            return staged;
+        }
+    };
+}
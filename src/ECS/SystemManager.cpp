@@ -1,14 +1,231 @@
 #include "SystemManager.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <ostream>
 
 namespace ECS {
+
+    namespace {
+        bool overlaps(const std::vector<SystemAccess::Entry>& a, const std::vector<SystemAccess::Entry>& b) {
+            for (const SystemAccess::Entry& left : a) {
+                for (const SystemAccess::Entry& right : b) {
+                    if (left.type == right.type) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        double millisecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    
+    bool SystemAccess::conflictsWith(const SystemAccess& other) const {
+        if (!isDeclared() || !other.isDeclared()) {
+            return true;
+        }
+        return overlaps(writeEntries, other.writeEntries) ||
+               overlaps(writeEntries, other.readEntries) ||
+               overlaps(readEntries, other.writeEntries);
+    }
+    
+    void SystemAccess::createStorages(ComponentRegistry& registry) const {
+        for (const Entry& entry : readEntries) {
+            entry.createStorage(registry);
+        }
+        for (const Entry& entry : writeEntries) {
+            entry.createStorage(registry);
+        }
+    }
+    
+    void SystemManager::buildGraph() {
+        size_t count = systems.size();
+        dependencies.assign(count, {});
+        dependents.assign(count, {});
+        
+        for (size_t later = 0; later < count; ++later) {
+            for (size_t earlier = 0; earlier < later; ++earlier) {
+                if (accesses[later].conflictsWith(accesses[earlier])) {
+                    dependencies[later].push_back(earlier);
+                    dependents[earlier].push_back(later);
+                }
+            }
+        }
+        graphDirty = false;
+    }
     
     void SystemManager::updateSystems(float deltaTime) {
-        for (auto& system : systems) {
-            system->update(deltaTime);
+        if (graphDirty) {
+            buildGraph();
+        }
+        lastRuns.assign(systems.size(), SystemRun{});
+        
+        auto frameStart = std::chrono::steady_clock::now();
+        if (pool && systems.size() > 1) {
+            runParallel(deltaTime, frameStart);
+        } else {
+            runSequential(deltaTime, frameStart);
+        }
+    }
+    
+    void SystemManager::runSequential(float deltaTime, std::chrono::steady_clock::time_point frameStart) {
+        for (size_t i = 0; i < systems.size(); ++i) {
+            lastRuns[i].startMs = millisecondsSince(frameStart);
+            CommandBuffer::Scope commandScope(commandBuffers[i].get());
+            systems[i]->update(deltaTime);
+            lastRuns[i].endMs = millisecondsSince(frameStart);
+        }
+    }
+    
+    void SystemManager::runParallel(float deltaTime, std::chrono::steady_clock::time_point frameStart) {
+        size_t count = systems.size();
+        auto remaining = std::make_unique<std::atomic<size_t>[]>(count);
+        for (size_t i = 0; i < count; ++i) {
+            remaining[i].store(dependencies[i].size(), std::memory_order_relaxed);
+        }
+        
+        std::mutex doneMutex;
+        std::condition_variable doneSignal;
+        size_t unfinished = count;
+        std::exception_ptr firstError; // Guarded by doneMutex
+        std::atomic<bool> failed{false};
+        
+        // Each finished system releases the dependents it was last to unblock.
+        // A throwing system must not escape the worker, so its exception is
+        // kept for the caller, and once one has failed the rest are only
+        // counted down, as runSequential() would stop at the throw.
+        std::function<void(size_t)> run = [&](size_t index) {
+            SystemRun& record = lastRuns[index];
+            record.worker = ThreadPool::currentWorker();
+            record.startMs = millisecondsSince(frameStart);
+            if (!failed.load(std::memory_order_acquire)) {
+                try {
+                    CommandBuffer::Scope commandScope(commandBuffers[index].get());
+                    systems[index]->update(deltaTime);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    if (!firstError) {
+                        firstError = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_release);
+                }
+            }
+            record.endMs = millisecondsSince(frameStart);
+            
+            for (size_t dependent : dependents[index]) {
+                if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    pool->submit([&run, dependent]() { run(dependent); });
+                }
+            }
+            
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (--unfinished == 0) {
+                doneSignal.notify_one();
+            }
+        };
+        
+        for (size_t i = 0; i < count; ++i) {
+            if (dependencies[i].empty()) {
+                pool->submit([&run, i]() { run(i); });
+            }
+        }
+        
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneSignal.wait(lock, [&unfinished]() { return unfinished == 0; });
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+    }
+    
+    void SystemManager::playbackCommands(World& world) {
+        for (auto& buffer : commandBuffers) {
+            if (!buffer->empty()) {
+                buffer->playback(world);
+            }
+        }
+    }
+    
+    void SystemManager::setWorkerThreads(size_t count) {
+        pool.reset();
+        if (count > 0) {
+            pool = std::make_unique<ThreadPool>(count);
+        }
+    }
+    
+    void SystemManager::dumpExecutionGraph(std::ostream& out) {
+        if (graphDirty) {
+            buildGraph();
+        }
+        
+        // Level = longest chain of dependencies; systems on one level may overlap
+        std::vector<size_t> levels(systems.size(), 0);
+        size_t levelCount = systems.empty() ? 0 : 1;
+        for (size_t i = 0; i < systems.size(); ++i) {
+            for (size_t dependency : dependencies[i]) {
+                levels[i] = std::max(levels[i], levels[dependency] + 1);
+            }
+            levelCount = std::max(levelCount, levels[i] + 1);
+        }
+        
+        bool timed = lastRuns.size() == systems.size();
+        double spanMs = 0.0;
+        double workMs = 0.0;
+        if (timed) {
+            for (const SystemRun& run : lastRuns) {
+                spanMs = std::max(spanMs, run.endMs);
+                workMs += run.endMs - run.startMs;
+            }
+        }
+        
+        out << "Systems: " << systems.size() << ", levels: " << levelCount
+            << ", workers: " << getWorkerThreads() << "\n";
+        if (timed && spanMs > 0.0) {
+            out << "Last frame: span " << spanMs << " ms, system time " << workMs
+                << " ms, parallelism " << workMs / spanMs << "x\n";
+        }
+        
+        for (size_t i = 0; i < systems.size(); ++i) {
+            out << "  [" << i << "] " << systems[i]->getName() << " level " << levels[i];
+            if (timed) {
+                out << " worker " << lastRuns[i].worker
+                    << " " << lastRuns[i].startMs << "-" << lastRuns[i].endMs << " ms";
+            }
+            
+            out << " after:";
+            if (dependencies[i].empty()) {
+                out << " -";
+            }
+            for (size_t dependency : dependencies[i]) {
+                out << " " << dependency;
+            }
+            
+            if (!accesses[i].isDeclared()) {
+                out << " (exclusive)";
+            }
+            out << "\n";
+            
+            for (const SystemAccess::Entry& entry : accesses[i].getReads()) {
+                out << "      reads  " << entry.name << "\n";
+            }
+            for (const SystemAccess::Entry& entry : accesses[i].getWrites()) {
+                out << "      writes " << entry.name << "\n";
+            }
         }
     }
     
     void SystemManager::clear() {
         systems.clear();
+        systemsByType.clear();
+        accesses.clear();
+        commandBuffers.clear();
+        dependencies.clear();
+        dependents.clear();
+        lastRuns.clear();
+        graphDirty = true;
     }
 }
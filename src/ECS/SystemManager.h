@@ -1,11 +1,75 @@
 #pragma once
 
+#include "CommandBuffer.h"
 #include "EntityManager.h"
 #include "ComponentRegistry.h"
+#include "ThreadPool.h"
+#include "TypeID.h"
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <iosfwd>
+#include <memory>
+#include <typeinfo>
 #include <vector>
 
 namespace ECS {
+    /**
+     * @brief Component types a system reads and writes during update().
+     *
+     * The scheduler lets two systems run at the same time only when neither
+     * writes a type the other touches. A system that declares nothing is
+     * treated as exclusive and never overlaps another system.
+     */
+    class SystemAccess {
+    public:
+        struct Entry {
+            ComponentTypeID type;
+            const char* name;
+            void (*createStorage)(ComponentRegistry&);
+        };
+
+        template<typename ComponentType>
+        SystemAccess& reads() {
+            add<ComponentType>(readEntries);
+            return *this;
+        }
+
+        template<typename ComponentType>
+        SystemAccess& writes() {
+            add<ComponentType>(writeEntries);
+            return *this;
+        }
+
+        bool isDeclared() const { return !readEntries.empty() || !writeEntries.empty(); }
+
+        /**
+         * @brief True if the two systems must not run concurrently.
+         */
+        bool conflictsWith(const SystemAccess& other) const;
+
+        /**
+         * @brief Creates every declared sparse-set storage up front.
+         *
+         * Looking up a storage for the first time grows the registry, which
+         * is not safe while other systems are running.
+         */
+        void createStorages(ComponentRegistry& registry) const;
+
+        const std::vector<Entry>& getReads() const { return readEntries; }
+        const std::vector<Entry>& getWrites() const { return writeEntries; }
+
+    private:
+        std::vector<Entry> readEntries;
+        std::vector<Entry> writeEntries;
+
+        template<typename ComponentType>
+        static void add(std::vector<Entry>& entries) {
+            entries.push_back({componentTypeID<ComponentType>(), typeid(ComponentType).name(),
+                               [](ComponentRegistry& registry) { registry.getAllComponents<ComponentType>(); }});
+        }
+    };
+
     /**
      * @brief Base class for ECS systems.
      */
@@ -14,14 +78,56 @@ namespace ECS {
         virtual ~ISystem() = default;
         virtual void update(float deltaTime) = 0;
         virtual const char* getName() const = 0;
+
+        /**
+         * @brief Declares the component types update() touches.
+         *
+         * Override to let the scheduler run this system alongside others.
+         * The default declares nothing, which keeps the system exclusive.
+         */
+        virtual void declareAccess(SystemAccess& access) const { (void)access; }
     };
     
     /**
      * @brief Manages system execution order and lifecycle.
+     *
+     * Each system depends on every earlier-registered system it conflicts
+     * with, which keeps registration order wherever order can matter. With
+     * worker threads enabled, systems whose dependencies have finished run
+     * in parallel on a thread pool; otherwise they run one after another in
+     * registration order. Systems running in parallel must not create or
+     * destroy entities, add or remove components, or create new queries
+     * directly; they record structural changes in World::commands(), which
+     * resolves to the running system's own CommandBuffer.
      */
     class SystemManager {
+    public:
+        /**
+         * @brief Timing of one system during the most recent update.
+         */
+        struct SystemRun {
+            int worker = -1;        // Pool worker index, -1 for the calling thread
+            double startMs = 0.0;   // Relative to the start of the frame
+            double endMs = 0.0;
+        };
+        
     private:
-        std::vector<std::unique_ptr<ISystem>> systems;
+        std::vector<std::unique_ptr<ISystem>> systems;  // Update order
+        std::vector<ISystem*> systemsByType;             // Indexed by systemTypeID<T>()
+        std::vector<SystemAccess> accesses;              // Parallel to systems
+        std::vector<std::unique_ptr<CommandBuffer>> commandBuffers; // Parallel to systems
+        
+        // Dependency graph, rebuilt after systems are added
+        std::vector<std::vector<size_t>> dependencies;   // Earlier systems each one waits for
+        std::vector<std::vector<size_t>> dependents;     // Later systems waiting on each one
+        bool graphDirty = true;
+        
+        std::unique_ptr<ThreadPool> pool;
+        std::vector<SystemRun> lastRuns;
+        
+        void buildGraph();
+        void runSequential(float deltaTime, std::chrono::steady_clock::time_point frameStart);
+        void runParallel(float deltaTime, std::chrono::steady_clock::time_point frameStart);
         
     public:
         /**
@@ -31,20 +137,80 @@ namespace ECS {
         SystemType* addSystem(Args&&... args) {
             auto system = std::make_unique<SystemType>(std::forward<Args>(args)...);
             SystemType* ptr = system.get();
+            
+            SystemAccess access;
+            ptr->declareAccess(access);
+            accesses.push_back(std::move(access));
+            commandBuffers.push_back(std::make_unique<CommandBuffer>());
             systems.push_back(std::move(system));
+            graphDirty = true;
+            
+            SystemTypeID typeID = systemTypeID<SystemType>();
+            if (typeID >= systemsByType.size()) {
+                systemsByType.resize(typeID + 1, nullptr);
+            }
+            if (!systemsByType[typeID]) {
+                systemsByType[typeID] = ptr;
+            }
             return ptr;
         }
         
         /**
-         * @brief Updates all systems in order.
+         * @brief Updates all systems, in parallel where their access allows.
+         *
+         * If a system throws, systems that have not started yet are skipped
+         * and the first exception is rethrown once every worker is done.
          */
         void updateSystems(float deltaTime);
         
+        /**
+         * @brief Sets the number of pool threads; 0 runs every system on the caller.
+         */
+        void setWorkerThreads(size_t count);
+        
+        size_t getWorkerThreads() const { return pool ? pool->size() : 0; }
+        
+        /**
+         * @brief Access declared by the most recently added system.
+         */
+        const SystemAccess& getLastAccess() const { return accesses.back(); }
+        
+        /**
+         * @brief Plays back every system's recorded commands in registration order.
+         * 
+         * Playback order depends only on registration order, never on which
+         * worker finished first.
+         */
+        void playbackCommands(World& world);
+        
+        /**
+         * @brief Per-system timings from the most recent update, in registration order.
+         */
+        const std::vector<SystemRun>& getLastRuns() const { return lastRuns; }
+        
+        /**
+         * @brief Writes the dependency graph and last frame's timings as text.
+         *
+         * Reports each system's level (longest dependency chain before it),
+         * worker, start/end time and dependencies, plus the frame's span and
+         * how much system time overlapped.
+         */
+        void dumpExecutionGraph(std::ostream& out);
+        
         /**
          * @brief Gets a system by type.
+         * 
+         * Systems registered under exactly SystemType are found with one
+         * array index. Looking a system up by a base class falls back to a
+         * dynamic_cast scan.
          */
         template<typename SystemType>
         SystemType* getSystem() const {
+            SystemTypeID typeID = systemTypeID<SystemType>();
+            if (typeID < systemsByType.size() && systemsByType[typeID]) {
+                return static_cast<SystemType*>(systemsByType[typeID]);
+            }
+            
             for (const auto& system : systems) {
                 if (auto* typedSystem = dynamic_cast<SystemType*>(system.get())) {
                     return typedSystem;
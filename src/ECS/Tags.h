@@ -0,0 +1,63 @@
+#pragma once
+
+#include "TypeID.h"
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+namespace ECS {
+    struct TagTypeFamily {};
+
+    /**
+     * @brief One bit per tag type; each entity carries one of these as its signature.
+     */
+    using TagMask = std::uint64_t;
+
+    static constexpr std::uint32_t MAX_TAG_TYPES = 64;
+
+    /**
+     * @brief Bit for a tag type, assigned the first time the tag is used.
+     *
+     * Tags are empty structs that mark what an entity is (PlayerTag,
+     * CitizenTag). They take no component storage: World keeps them as
+     * bits in a per-entity mask, so testing or counting roles across the
+     * population is bitwise work over one flat array.
+     */
+    template<typename Tag>
+    TagMask tagBit() {
+        static_assert(std::is_empty_v<Tag>, "tags must be empty types; use a component for data");
+        std::uint32_t id = TypeIndexer<TagTypeFamily>::get<Tag>();
+        assert(id < MAX_TAG_TYPES && "too many tag types for TagMask");
+        return TagMask{1} << id;
+    }
+
+    template<typename... Tags>
+    TagMask tagMask() {
+        return (TagMask{0} | ... | tagBit<Tags>());
+    }
+
+    /**
+     * @brief Matches entities whose signature has every bit of all and no bit of none.
+     */
+    struct TagQuery {
+        TagMask all = 0;
+        TagMask none = 0;
+
+        bool matches(TagMask tags) const {
+            return (tags & all) == all && (tags & none) == 0;
+        }
+
+        template<typename... Tags>
+        TagQuery without() const {
+            return {all, none | tagMask<Tags...>()};
+        }
+    };
+
+    /**
+     * @brief Query for entities carrying every one of Tags, e.g. world.view<Movement>(ECS::withTags<PlayerTag>()).
+     */
+    template<typename... Tags>
+    TagQuery withTags() {
+        return {tagMask<Tags...>(), 0};
+    }
+}
@@ -0,0 +1,56 @@
+#include "ThreadPool.h"
+
+namespace ECS {
+
+    namespace {
+        thread_local int workerIndex = -1;
+    }
+
+    ThreadPool::ThreadPool(size_t threadCount) {
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back([this, i]() { workerLoop(static_cast<int>(i)); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        available.notify_one();
+    }
+
+    int ThreadPool::currentWorker() {
+        return workerIndex;
+    }
+
+    void ThreadPool::workerLoop(int index) {
+        workerIndex = index;
+
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    return; // Stopping and drained
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
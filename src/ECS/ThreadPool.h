@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Fixed set of worker threads pulling tasks from a shared queue.
+     */
+    class ThreadPool {
+    public:
+        explicit ThreadPool(size_t threadCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Queues a task to run on the next free worker.
+         */
+        void submit(std::function<void()> task);
+
+        size_t size() const { return workers.size(); }
+
+        /**
+         * @brief Index of the pool worker running the caller, or -1 off the pool.
+         */
+        static int currentWorker();
+
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable available;
+        bool stopping = false;
+
+        void workerLoop(int index);
+    };
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ECS {
+    /**
+     * @brief Dense per-type integer IDs, one counter per Family.
+     *
+     * Each type receives the next free ID the first time it is looked up,
+     * and keeps it for the rest of the run. IDs start at 0 and have no
+     * gaps, so they can index flat vectors directly. After the first call
+     * for a type, get() is a guarded static load with no hashing.
+     */
+    template<typename Family>
+    class TypeIndexer {
+    public:
+        template<typename Type>
+        static std::uint32_t get() {
+            static const std::uint32_t id = next();
+            return id;
+        }
+
+        /**
+         * @brief Number of IDs handed out so far for this family.
+         */
+        static std::uint32_t count() {
+            return counter().load(std::memory_order_relaxed);
+        }
+
+    private:
+        static std::atomic<std::uint32_t>& counter() {
+            static std::atomic<std::uint32_t> value{0};
+            return value;
+        }
+
+        static std::uint32_t next() {
+            return counter().fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    struct ComponentTypeFamily {};
+    struct SystemTypeFamily {};
+    struct QueryTypeFamily {};
+
+    using ComponentTypeID = std::uint32_t;
+    using SystemTypeID = std::uint32_t;
+
+    template<typename ComponentType>
+    ComponentTypeID componentTypeID() {
+        return TypeIndexer<ComponentTypeFamily>::get<ComponentType>();
+    }
+
+    template<typename SystemType>
+    SystemTypeID systemTypeID() {
+        return TypeIndexer<SystemTypeFamily>::get<SystemType>();
+    }
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "ComponentRegistry.h"
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace ECS {
+    /**
+     * @brief Marker listing component types a view must skip.
+     *
+     * Usage: world.view<PositionComponent, Movement>(ECS::exclude<PlayerTag>)
+     */
+    template<typename... Excluded>
+    struct Exclude {};
+
+    template<typename... Excluded>
+    inline constexpr Exclude<Excluded...> exclude{};
+
+    /**
+     * @brief Filter for entities whose ComponentType was added after since.
+     *
+     * Usage: world.view<AIState, Movement>(ECS::Added<Movement>(lastRead))
+     */
+    template<typename ComponentType>
+    struct Added {
+        using Component = ComponentType;
+        ChangeTick since;
+
+        explicit Added(ChangeTick since) : since(since) {}
+
+        void collect(const ComponentStorage<ComponentType>& storage, std::vector<EntityID>& out) const {
+            storage.collectAdded(since, out);
+        }
+    };
+
+    /**
+     * @brief Filter for entities whose ComponentType was added or marked changed after since.
+     */
+    template<typename ComponentType>
+    struct Changed {
+        using Component = ComponentType;
+        ChangeTick since;
+
+        explicit Changed(ChangeTick since) : since(since) {}
+
+        void collect(const ComponentStorage<ComponentType>& storage, std::vector<EntityID>& out) const {
+            storage.collectChanged(since, out);
+        }
+    };
+
+    /**
+     * @brief Filter for entities that lost ComponentType after since.
+     *
+     * The removed component can no longer be viewed, so list the other
+     * components the entity should still have, or none to get bare IDs
+     * (including those of destroyed entities).
+     */
+    template<typename ComponentType>
+    struct Removed {
+        using Component = ComponentType;
+        ChangeTick since;
+
+        explicit Removed(ChangeTick since) : since(since) {}
+
+        void collect(const ComponentStorage<ComponentType>& storage, std::vector<EntityID>& out) const {
+            storage.collectRemoved(since, out);
+        }
+    };
+
+    template<typename Filter>
+    concept ChangeFilter = requires(const Filter& filter, const ComponentStorage<typename Filter::Component>& storage,
+                                    std::vector<EntityID>& out) {
+        filter.collect(storage, out);
+    };
+
+    /**
+     * @brief Join over several sparse-set component storages.
+     *
+     * The view drives iteration from whichever included storage is smallest
+     * and probes the others through their sparse indices, so the cost is
+     * proportional to the rarest component rather than the most common.
+     * Iteration yields (EntityID, Components&...) tuples, which unpack with
+     * structured bindings:
+     *
+     *     for (auto [id, pos, move] : world.view<PositionComponent, Movement>()) { ... }
+     *
+     * Components must not be added to or removed from the viewed storages
+     * while iterating.
+     *
+     * A view built with a change filter is driven by the entities the filter
+     * collected instead, so it only visits what changed.
+     */
+    template<typename... Components>
+    class View {
+    public:
+        using Storages = std::tuple<ComponentStorage<Components>*...>;
+        using value_type = std::tuple<EntityID, Components&...>;
+
+        class iterator {
+        public:
+            iterator(const View* view, size_t index) : view(view), index(index) { skipUnmatched(); }
+
+            value_type operator*() const {
+                EntityID entityID = (*view->driver)[index];
+                return std::tuple_cat(std::make_tuple(entityID), view->get(entityID));
+            }
+
+            iterator& operator++() {
+                ++index;
+                skipUnmatched();
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return index == other.index; }
+            bool operator!=(const iterator& other) const { return index != other.index; }
+
+        private:
+            const View* view;
+            size_t index;
+
+            void skipUnmatched() {
+                while (index < view->driver->size() && !view->contains((*view->driver)[index])) {
+                    ++index;
+                }
+            }
+        };
+
+        View(Storages storages, std::vector<const IComponentStorage*> excluded,
+             std::shared_ptr<const std::vector<EntityID>> candidates = nullptr)
+            : storages(storages), excluded(std::move(excluded)), candidates(std::move(candidates))
+        {
+            if (this->candidates) {
+                driver = this->candidates.get();
+                return;
+            }
+            size_t smallest = std::numeric_limits<size_t>::max();
+            std::apply([this, &smallest](auto*... storage) {
+                ((storage->size() < smallest ? (smallest = storage->size(), driver = &storage->getEntities(), 0) : 0), ...);
+            }, this->storages);
+        }
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, driver->size()); }
+
+        /**
+         * @brief Calls func(EntityID, Components&...) for each matching entity.
+         */
+        template<typename Func>
+        void each(Func&& func) const {
+            for (EntityID entityID : *driver) {
+                if (contains(entityID)) {
+                    std::apply([&](Components&... components) { func(entityID, components...); }, get(entityID));
+                }
+            }
+        }
+
+        /**
+         * @brief True if the entity has every included and no excluded component.
+         */
+        bool contains(EntityID entityID) const {
+            bool included = std::apply([entityID](auto*... storage) {
+                return ((storage->getComponent(entityID) != nullptr) && ...);
+            }, storages);
+            if (!included) {
+                return false;
+            }
+            for (const IComponentStorage* storage : excluded) {
+                if (storage->hasComponent(entityID)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Component references for an entity already known to match.
+         */
+        std::tuple<Components&...> get(EntityID entityID) const {
+            return std::apply([entityID](auto*... storage) {
+                return std::tuple<Components&...>(*storage->getComponent(entityID)...);
+            }, storages);
+        }
+
+        /**
+         * @brief Upper bound on the number of matches (size of the driving storage).
+         */
+        size_t sizeHint() const { return driver->size(); }
+
+        /**
+         * @brief Every storage whose membership affects this view's results.
+         */
+        std::vector<const IComponentStorage*> getWatchedStorages() const {
+            std::vector<const IComponentStorage*> watched = excluded;
+            std::apply([&watched](auto*... storage) { (watched.push_back(storage), ...); }, storages);
+            return watched;
+        }
+
+    private:
+        Storages storages;
+        std::vector<const IComponentStorage*> excluded;
+        std::shared_ptr<const std::vector<EntityID>> candidates; // Set by change filters
+        const std::vector<EntityID>* driver = nullptr; // Candidates, or entities of the smallest included storage
+    };
+
+    /**
+     * @brief Base class for type-erased cached queries owned by the World.
+     */
+    class ICachedQuery {
+    public:
+        virtual ~ICachedQuery() = default;
+    };
+
+    /**
+     * @brief A View whose matching entities are remembered between calls.
+     *
+     * The entity list is rebuilt lazily the first time it is used after any
+     * included or excluded storage gains or loses a component. Changing a
+     * component's value does not invalidate the cache.
+     */
+    template<typename... Components>
+    class CachedQuery : public ICachedQuery {
+    public:
+        explicit CachedQuery(View<Components...> view)
+            : view(std::move(view)), watched(this->view.getWatchedStorages()),
+              versions(watched.size(), std::numeric_limits<std::uint64_t>::max())
+        {
+        }
+
+        /**
+         * @brief Matching entities, rebuilt only if a watched storage changed.
+         */
+        const std::vector<EntityID>& getEntities() {
+            refresh();
+            return entities;
+        }
+
+        /**
+         * @brief Calls func(EntityID, Components&...) for each cached entity.
+         */
+        template<typename Func>
+        void each(Func&& func) {
+            refresh();
+            for (EntityID entityID : entities) {
+                std::apply([&](Components&... components) { func(entityID, components...); }, view.get(entityID));
+            }
+        }
+
+        size_t size() {
+            refresh();
+            return entities.size();
+        }
+
+    private:
+        View<Components...> view;
+        std::vector<const IComponentStorage*> watched;
+        std::vector<std::uint64_t> versions;
+        std::vector<EntityID> entities;
+
+        void refresh() {
+            bool stale = false;
+            for (size_t i = 0; i < watched.size(); ++i) {
+                if (watched[i]->getVersion() != versions[i]) {
+                    versions[i] = watched[i]->getVersion();
+                    stale = true;
+                }
+            }
+            if (!stale) {
+                return;
+            }
+
+            entities.clear();
+            view.each([this](EntityID entityID, Components&...) { entities.push_back(entityID); });
+        }
+    };
+}
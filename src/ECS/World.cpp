@@ -2,17 +2,31 @@
 
 namespace ECS {
     
+    World::World(StorageBackend backend) : commandBuffer(std::make_unique<CommandBuffer>()) {
+        if (backend == StorageBackend::Archetype) {
+            archetypeStorage = std::make_unique<ArchetypeStorage>();
+        }
+    }
+    
     EntityID World::createEntity() {
         return entityManager.createEntity();
     }
     
+    size_t World::createEntities(size_t count, std::vector<EntityID>& out) {
+        return entityManager.createEntities(count, out);
+    }
+    
     bool World::destroyEntity(EntityID entityID) {
         if (!entityManager.isAlive(entityID)) {
             return false;
         }
         
         // Remove all components from the entity
-        componentRegistry.removeAllComponents(entityID);
+        if (archetypeStorage) {
+            archetypeStorage->removeAllComponents(entityID);
+        } else {
+            componentRegistry.removeAllComponents(entityID);
+        }
         
         // Destroy the entity
         return entityManager.destroyEntity(entityID);
@@ -22,12 +36,21 @@ namespace ECS {
         return entityManager.isAlive(entityID);
     }
     
-    std::vector<EntityID> World::getAllEntities() const {
+    const std::vector<EntityID>& World::getAllEntities() const {
         return entityManager.getAllEntities();
     }
     
     void World::update(float deltaTime) {
         systemManager.updateSystems(deltaTime);
+        flushCommands();
+        eventBus.dispatch();
+    }
+    
+    void World::flushCommands() {
+        systemManager.playbackCommands(*this);
+        if (!commandBuffer->empty()) {
+            commandBuffer->playback(*this);
+        }
     }
     
     size_t World::getEntityCount() const {
@@ -36,7 +59,35 @@ namespace ECS {
     
     void World::clear() {
         systemManager.clear();
+        commandBuffer->clear();
+        eventBus.clear();
+        cachedQueries.clear();
         componentRegistry.clear();
+        if (archetypeStorage) {
+            archetypeStorage->clear();
+        }
         entityManager.clear();
     }
+    
+    size_t World::countTagged(TagQuery query) const {
+        size_t count = 0;
+        forEachTagged(query, [&count](EntityID) { ++count; });
+        return count;
+    }
+    
+    void World::saveCheckpoint(WorldCheckpoint& checkpoint) const {
+        assert(!archetypeStorage && "checkpoints require the sparse-set backend");
+        checkpoint.entities = entityManager;
+        componentRegistry.copyStoragesTo(checkpoint.storages);
+        checkpoint.saved = true;
+    }
+    
+    void World::restoreCheckpoint(const WorldCheckpoint& checkpoint) {
+        assert(!archetypeStorage && "checkpoints require the sparse-set backend");
+        assert(!checkpoint.empty());
+        commandBuffer->clear();
+        eventBus.clear();
+        entityManager = checkpoint.entities;
+        componentRegistry.restoreStorages(checkpoint.storages);
+    }
 }
@@ -1,29 +1,113 @@
 #pragma once
 
 #include "EntityManager.h"
+#include "Tags.h"
 #include "ComponentRegistry.h"
+#include "ArchetypeStorage.h"
+#include "View.h"
 #include "SystemManager.h"
+#include "EventBus.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 namespace ECS {
+    /**
+     * @brief In-memory copy of a World's entities and components.
+     * 
+     * Filled by World::saveCheckpoint() and applied by
+     * World::restoreCheckpoint(). A checkpoint keeps its buffers between
+     * saves, so reusing one (for instance from a CheckpointRing) makes
+     * both directions a copy into memory that is already allocated.
+     */
+    class WorldCheckpoint {
+    public:
+        bool empty() const { return !saved; }
+        
+        /**
+         * @brief Memory held by the copied component storages.
+         */
+        PoolStats getPoolStats() const {
+            PoolStats stats;
+            for (const auto& storage : storages) {
+                if (storage) {
+                    stats += storage->getPoolStats();
+                }
+            }
+            return stats;
+        }
+        
+    private:
+        friend class World;
+        
+        EntityManager entities;
+        std::vector<std::unique_ptr<IComponentStorage>> storages; // Indexed by component type ID
+        bool saved = false;
+    };
+    
     /**
      * @brief Central ECS World that coordinates entities, components, and systems.
      * 
      * This is the main interface for ECS operations and replaces the scattered
      * entity/component management across the Scene and individual managers.
+     * 
+     * Components are kept either in per-type sparse sets (the default) or,
+     * when constructed with StorageBackend::Archetype, in archetype chunks.
+     * Archetypes make forEach() over several components a scan of
+     * contiguous columns at the cost of moving rows whenever an entity's
+     * component set changes.
      */
     class World {
+    public:
+        enum class StorageBackend {
+            SparseSet,
+            Archetype
+        };
+        
     private:
         EntityManager entityManager;
         ComponentRegistry componentRegistry;
+        std::unique_ptr<ArchetypeStorage> archetypeStorage; // Set only for the archetype backend
         SystemManager systemManager;
+        std::vector<std::unique_ptr<ICachedQuery>> cachedQueries; // Indexed by query type ID
+        std::unique_ptr<CommandBuffer> commandBuffer;   // Used outside system updates
+        EventBus eventBus;
+        
+        /**
+         * @brief Aborts in every build type if this is an archetype world.
+         *
+         * Sparse-set calls on an archetype world would otherwise see empty
+         * storages and quietly return nothing.
+         */
+        void requireSparseSets(const char* what) const {
+            if (archetypeStorage) {
+                std::fprintf(stderr, "ECS::World::%s requires the sparse-set backend\n", what);
+                std::abort();
+            }
+        }
         
     public:
+        explicit World(StorageBackend backend = StorageBackend::SparseSet);
+        
+        StorageBackend getStorageBackend() const {
+            return archetypeStorage ? StorageBackend::Archetype : StorageBackend::SparseSet;
+        }
+        
         /**
          * @brief Creates a new entity.
          * @return EntityID The unique identifier for the new entity.
          */
         EntityID createEntity();
         
+        /**
+         * @brief Creates count entities in one batch, appending their IDs to out.
+         * @return size_t How many were created; fewer than count once the index space runs out.
+         */
+        size_t createEntities(size_t count, std::vector<EntityID>& out);
+        
         /**
          * @brief Destroys an entity and all its components.
          * @param entityID The ID of the entity to destroy.
@@ -50,6 +134,9 @@ namespace ECS {
             if (!entityManager.isAlive(entityID)) {
                 return nullptr;
             }
+            if (archetypeStorage) {
+                return archetypeStorage->addComponent<ComponentType>(entityID, std::forward<Args>(args)...);
+            }
             return componentRegistry.addComponent<ComponentType>(entityID, std::forward<Args>(args)...);
         }
         
@@ -61,6 +148,9 @@ namespace ECS {
          */
         template<typename ComponentType>
         ComponentType* getComponent(EntityID entityID) const {
+            if (archetypeStorage) {
+                return archetypeStorage->getComponent<ComponentType>(entityID);
+            }
             return componentRegistry.getComponent<ComponentType>(entityID);
         }
         
@@ -72,6 +162,9 @@ namespace ECS {
          */
         template<typename ComponentType>
         bool hasComponent(EntityID entityID) const {
+            if (archetypeStorage) {
+                return archetypeStorage->hasComponent<ComponentType>(entityID);
+            }
             return componentRegistry.hasComponent<ComponentType>(entityID);
         }
         
@@ -82,22 +175,212 @@ namespace ECS {
          */
         template<typename ComponentType>
         void removeComponent(EntityID entityID) {
+            if (archetypeStorage) {
+                archetypeStorage->removeComponent<ComponentType>(entityID);
+                return;
+            }
             componentRegistry.removeComponent<ComponentType>(entityID);
         }
         
         /**
          * @brief Gets all entities.
-         * @return std::vector<EntityID> Vector of all living entity IDs.
+         * @return Packed array of living entity IDs, valid until the next create or destroy.
+         */
+        const std::vector<EntityID>& getAllEntities() const;
+        
+        /**
+         * @brief Calls func(EntityID, Components&...) for every entity that has all Components.
+         * 
+         * With the archetype backend this walks matching chunks column by
+         * column. With sparse sets it runs a view(), driven by the smallest
+         * storage. Do not add or remove components of the visited types from
+         * inside func.
+         */
+        template<typename First, typename... Rest, typename Func>
+        void forEach(Func&& func) {
+            if (archetypeStorage) {
+                archetypeStorage->forEach<First, Rest...>(std::forward<Func>(func));
+                return;
+            }
+            
+            view<First, Rest...>().each(std::forward<Func>(func));
+        }
+        
+        /**
+         * @brief Joins several component types, driven by the smallest storage.
+         * 
+         * Iterate with structured bindings or call each(). Requires the
+         * sparse-set backend and aborts without it; archetype worlds
+         * should use forEach().
+         * @tparam Components Types every visited entity must have.
+         * @param excluded ECS::exclude<Types...> that visited entities must not have.
+         */
+        template<typename... Components, typename... Excluded>
+        View<Components...> view(Exclude<Excluded...> excluded = {}) {
+            static_assert(sizeof...(Components) > 0, "view needs at least one component type");
+            (void)excluded;
+            requireSparseSets("view");
+            return View<Components...>(
+                std::make_tuple(&componentRegistry.getAllComponents<Components>()...),
+                { &componentRegistry.getAllComponents<Excluded>()... });
+        }
+        
+        /**
+         * @brief Joins several component types over only the entities a change filter selects.
+         * 
+         * Costs time proportional to the changes since the filter's tick, not
+         * to the size of any storage:
+         * 
+         *     ECS::ChangeTick since = world.beginChangeRead(lastRead);
+         *     for (auto [id, ai] : world.view<AIState>(ECS::Changed<Movement>(since))) { ... }
+         * 
+         * Requires the sparse-set backend.
+         */
+        template<typename... Components, ChangeFilter Filter, typename... Excluded>
+        View<Components...> view(Filter filter, Exclude<Excluded...> excluded = {}) {
+            (void)excluded;
+            requireSparseSets("view");
+            auto candidates = std::make_shared<std::vector<EntityID>>();
+            filter.collect(componentRegistry.getAllComponents<typename Filter::Component>(), *candidates);
+            return View<Components...>(
+                std::make_tuple(&componentRegistry.getAllComponents<Components>()...),
+                { &componentRegistry.getAllComponents<Excluded>()... },
+                std::move(candidates));
+        }
+        
+        /**
+         * @brief Joins several component types over only the entities whose tags match query.
+         * 
+         * Candidates come from a scan of the flat tag signature array, so
+         * the join only looks up components for entities with the right role.
+         * Requires the sparse-set backend.
+         */
+        template<typename... Components, typename... Excluded>
+        View<Components...> view(TagQuery query, Exclude<Excluded...> excluded = {}) {
+            (void)excluded;
+            requireSparseSets("view");
+            auto candidates = std::make_shared<std::vector<EntityID>>();
+            forEachTagged(query, [&candidates](EntityID entityID) { candidates->push_back(entityID); });
+            return View<Components...>(
+                std::make_tuple(&componentRegistry.getAllComponents<Components>()...),
+                { &componentRegistry.getAllComponents<Excluded>()... },
+                std::move(candidates));
+        }
+        
+        /**
+         * @brief Marks an entity with one or more tags.
+         * @return bool False if the entity is not alive.
+         */
+        template<typename... Tags>
+        bool addTag(EntityID entityID) {
+            return entityManager.addTags(entityID, tagMask<Tags...>());
+        }
+        
+        template<typename... Tags>
+        bool removeTag(EntityID entityID) {
+            return entityManager.removeTags(entityID, tagMask<Tags...>());
+        }
+        
+        /**
+         * @brief True if the entity carries every one of Tags.
+         */
+        template<typename... Tags>
+        bool hasTags(EntityID entityID) const {
+            TagMask mask = tagMask<Tags...>();
+            return (entityManager.getTags(entityID) & mask) == mask;
+        }
+        
+        TagMask getTags(EntityID entityID) const { return entityManager.getTags(entityID); }
+        
+        /**
+         * @brief Calls func(EntityID) for every living entity whose tags match query, in slot order.
+         */
+        template<typename Func>
+        void forEachTagged(TagQuery query, Func&& func) const {
+            const auto& tags = entityManager.getTagMasks();
+            const auto& slots = entityManager.getSlots();
+            for (std::uint32_t index = 1; index < tags.size(); ++index) {
+                // Free slots hold no tags but still match an empty query
+                if (query.matches(tags[index]) && entityIndex(slots[index]) == index) {
+                    func(slots[index]);
+                }
+            }
+        }
+        
+        /**
+         * @brief Number of living entities whose tags match query.
+         */
+        size_t countTagged(TagQuery query) const;
+        
+        /**
+         * @brief Stamps an entity's component as changed so Changed<ComponentType> filters see it.
+         * 
+         * Writes through component references are not tracked on their own.
+         * Only the sparse-set backend records changes.
+         * @return False if the entity has no such component.
+         */
+        template<typename ComponentType>
+        bool markChanged(EntityID entityID) {
+            if (archetypeStorage) {
+                return false;
+            }
+            return componentRegistry.getAllComponents<ComponentType>().markChanged(entityID);
+        }
+        
+        /**
+         * @brief Starts a change read for a reader that keeps its own last-read tick.
+         * 
+         * Returns the reader's previous tick, to pass as `since` to change
+         * filters, and moves lastRead to the current tick. Changes made after
+         * this call get a later tick, so the reader's next read picks them up.
+         * A lastRead of 0 sees every change still logged.
          */
-        std::vector<EntityID> getAllEntities() const;
+        ChangeTick beginChangeRead(ChangeTick& lastRead) {
+            ChangeTick since = lastRead;
+            lastRead = componentRegistry.advanceChangeTick();
+            return since;
+        }
+        
+        ChangeTick getChangeTick() const {
+            return componentRegistry.getChangeTick();
+        }
+        
+        /**
+         * @brief Returns a cached query whose entity list survives between frames.
+         * 
+         * The list is only rebuilt after an included or excluded storage
+         * gains or loses a component. Requires the sparse-set backend.
+         */
+        template<typename... Components, typename... Excluded>
+        CachedQuery<Components...>& query(Exclude<Excluded...> excluded = {}) {
+            using QueryKey = std::tuple<std::tuple<Components...>, std::tuple<Excluded...>>;
+            std::uint32_t queryID = TypeIndexer<QueryTypeFamily>::get<QueryKey>();
+            if (queryID >= cachedQueries.size()) {
+                cachedQueries.resize(queryID + 1);
+            }
+            if (!cachedQueries[queryID]) {
+                cachedQueries[queryID] = std::make_unique<CachedQuery<Components...>>(view<Components...>(excluded));
+            }
+            return static_cast<CachedQuery<Components...>&>(*cachedQueries[queryID]);
+        }
         
         /**
          * @brief Gets all components of a specific type.
+         * 
+         * Requires the sparse-set backend and aborts without it; use
+         * forEach() for code that must work with either backend.
          * @tparam ComponentType The type of component to get.
-         * @return const auto& Reference to the component storage map.
+         * @return Reference to the packed component storage, iterable as (EntityID, ComponentType&).
          */
         template<typename ComponentType>
-        const auto& getAllComponents() const {
+        ComponentStorage<ComponentType>& getAllComponents() {
+            requireSparseSets("getAllComponents");
+            return componentRegistry.getAllComponents<ComponentType>();
+        }
+        
+        template<typename ComponentType>
+        const ComponentStorage<ComponentType>& getAllComponents() const {
+            requireSparseSets("getAllComponents");
             return componentRegistry.getAllComponents<ComponentType>();
         }
         
@@ -109,7 +392,18 @@ namespace ECS {
          */
         template<typename SystemType, typename... Args>
         SystemType* addSystem(Args&&... args) {
-            return systemManager.addSystem<SystemType>(std::forward<Args>(args)...);
+            SystemType* system = systemManager.addSystem<SystemType>(std::forward<Args>(args)...);
+            if (!archetypeStorage) {
+                systemManager.getLastAccess().createStorages(componentRegistry);
+            }
+            return system;
+        }
+        
+        /**
+         * @brief Runs non-conflicting systems on this many pool threads (0 = serial).
+         */
+        void setWorkerThreads(size_t count) {
+            systemManager.setWorkerThreads(count);
         }
         
         /**
@@ -123,11 +417,36 @@ namespace ECS {
         }
         
         /**
-         * @brief Updates all systems.
+         * @brief Updates all systems, plays back their recorded commands, then dispatches events.
          * @param deltaTime Time elapsed since last update.
          */
         void update(float deltaTime);
         
+        /**
+         * @brief Command buffer for deferred structural changes.
+         * 
+         * Inside a system update this is that system's own buffer; elsewhere
+         * it is the world's buffer. Either way the changes land at the next
+         * flushCommands(), which update() calls after the systems finish.
+         */
+        CommandBuffer& commands() {
+            CommandBuffer* current = CommandBuffer::current();
+            return current ? *current : *commandBuffer;
+        }
+        
+        /**
+         * @brief Sync point: applies all recorded commands, systems first in registration order.
+         */
+        void flushCommands();
+        
+        /**
+         * @brief Typed event queues; update() dispatches them once its systems are done.
+         * 
+         * Code that does not run through update() should call
+         * events().dispatch() at a fixed point in its own frame.
+         */
+        EventBus& events() { return eventBus; }
+        
         /**
          * @brief Gets entity count.
          * @return size_t Number of living entities.
@@ -139,9 +458,45 @@ namespace ECS {
          */
         void clear();
         
+        /**
+         * @brief Copies every entity and component into checkpoint.
+         * 
+         * Takes time proportional to the state size and does not allocate
+         * once checkpoint has held a state of similar size. Requires the
+         * sparse-set backend.
+         */
+        void saveCheckpoint(WorldCheckpoint& checkpoint) const;
+        
+        /**
+         * @brief Puts every entity and component back as they were in checkpoint.
+         * 
+         * Handles, generations, the free list and dense iteration order are
+         * restored exactly, and existing buffers are overwritten in place.
+         * Systems, subscriptions and the change tick are kept; queued
+         * commands and events belong to the abandoned timeline and are
+         * dropped. Change readers see restored ticks, so they should treat a
+         * restore as a reset and rescan. Requires the sparse-set backend.
+         */
+        void restoreCheckpoint(const WorldCheckpoint& checkpoint);
+        
         // Accessors for individual managers (for migration period)
         EntityManager& getEntityManager() { return entityManager; }
+        const EntityManager& getEntityManager() const { return entityManager; }
         ComponentRegistry& getComponentRegistry() { return componentRegistry; }
+        ArchetypeStorage* getArchetypeStorage() { return archetypeStorage.get(); }
         SystemManager& getSystemManager() { return systemManager; }
     };
+    
+    template<typename ComponentType>
+    void applyAddComponent(World& world, EntityID entityID, void* payload) {
+        auto* component = static_cast<ComponentType*>(payload);
+        world.addComponent<ComponentType>(entityID, std::move(*component));
+        component->~ComponentType();
+    }
+    
+    template<typename ComponentType>
+    void applyRemoveComponent(World& world, EntityID entityID, void* payload) {
+        (void)payload;
+        world.removeComponent<ComponentType>(entityID);
+    }
 }
@@ -2,6 +2,12 @@
 #include <string>
 #include "../IComponent.h"
 
+/**
+ * @brief Names the controller type from the scene file.
+ *
+ * Kept for display and save files; role checks use the tags in
+ * RoleTags.h, which the scene sets alongside this component.
+ */
 class Controller : public ECS::IComponent {
 
 public:
@@ -30,6 +30,9 @@ struct Movement : public ECS::IComponent {
 
     /**
      * @brief Sets a new target destination and transitions to moving phase.
+     *
+     * Touches only the component. In a world driven by MovementManager use
+     * MovementManager::setTarget(), which also marks the change.
      */
     void setTarget(float x, float y) {
         targetX = x;
@@ -39,15 +42,6 @@ struct Movement : public ECS::IComponent {
         phaseTimer = 0.0f;
     }
     
-    /**
-     * @brief Transitions to planning phase.
-     */
-    void startPlanning() {
-        phase = MovementPhase::PLANNING;
-        phaseTimer = 0.0f;
-        isMoving = false;
-    }
-    
     /**
      * @brief Checks if entity can accept new movement commands.
      */
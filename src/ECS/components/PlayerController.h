@@ -1,16 +1,20 @@
 #pragma once
 
 #include "Controller.h"
-#include <SDL3/SDL.h>
+#include "../EntityID.h"
 
 // Forward declarations to break circular dependencies
-class MovementManager;
-class PositionManager;
+namespace ECS { class World; }
 class Grid;
 
 /**
  * @class PlayerController
- * @brief A controller that translates user keyboard input into entity movement.
+ * @brief A controller that translates user step commands into entity movement.
+ *
+ * Keyboard mapping happens in the frontend; this class only knows about grid
+ * steps so it carries no SDL dependency. Player entities carry PlayerTag
+ * and a plain Controller component of type "player"; the stepping logic
+ * works on their components in the world.
  */
 class PlayerController : public Controller
 {
@@ -18,15 +22,19 @@ public:
     PlayerController() : Controller("player") {}
 
     /**
-     * @brief Handles SDL keyboard events to move the player entity.
-     * @param event The SDL_Event to process.
-     * @param uid The UID of the entity this controller belongs to.
-     * @param moveManager Reference to the MovementManager.
-     * @param posManager Reference to the PositionManager.
+     * @brief Steps every entity tagged PlayerTag.
+     */
+    static void stepPlayers(int stepX, int stepY, ECS::World& world, const Grid& grid, int cellSize);
+
+    /**
+     * @brief Moves the player entity one grid cell in the given direction.
+     * @param stepX Horizontal step in cells (-1, 0 or 1).
+     * @param stepY Vertical step in cells (-1, 0 or 1).
+     * @param entity The entity this controller belongs to.
+     * @param world The world holding the entity's Movement and PositionComponent.
      * @param grid The game grid, for collision checks.
      * @param cellSize The size of a grid cell in pixels.
      */
-    void handleEvent(const SDL_Event& event, unsigned int uid, 
-                    MovementManager& moveManager, PositionManager& posManager, 
-                    const Grid& grid, int cellSize);
-};
\ No newline at end of file
+    static void step(int stepX, int stepY, ECS::EntityID entity,
+                     ECS::World& world, const Grid& grid, int cellSize);
+};
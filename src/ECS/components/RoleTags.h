@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * @file RoleTags.h
+ * @brief Tags marking what part an entity plays in the town.
+ *
+ * Scene loading sets one from the "controller" type; code that needs to
+ * find players or citizens tests signature bits instead of comparing
+ * Controller::type strings.
+ */
+
+/** @brief Steered by keyboard input. */
+struct PlayerTag {};
+
+/** @brief AI-driven guardian. */
+struct GuardianTag {};
+
+/** @brief AI-driven citizen with a home and a daily schedule. */
+struct CitizenTag {};
@@ -0,0 +1,19 @@
+#pragma once
+#include "../EntityID.h"
+#include <string>
+
+/**
+ * @brief Emitted when an NPC reaches the zone it was heading for.
+ */
+struct ZoneEntered {
+    ECS::EntityID entity;
+    const std::string* zone; // Key in Grid::zones
+};
+
+/**
+ * @brief Emitted when an NPC stops performing its activity to plan the next one.
+ */
+struct ActivityFinished {
+    ECS::EntityID entity;
+    bool timerExpired; // False if the time of day called for something else
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include "../EntityID.h"
+#include "../components/Movement.h"
+
+/**
+ * @brief Emitted whenever an entity's Movement::phase changes.
+ */
+struct MovementPhaseChanged {
+    ECS::EntityID entity;
+    MovementPhase from;
+    MovementPhase to;
+};
+
+/**
+ * @brief Emitted when a moving entity reaches its movement target.
+ */
+struct MovementArrived {
+    ECS::EntityID entity;
+    float x;
+    float y;
+};
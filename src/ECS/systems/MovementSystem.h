@@ -2,6 +2,7 @@
 
 #include "../SystemManager.h"
 #include "../World.h"
+#include "../MovementManager.h"
 #include "../components/PositionComponent.h"
 #include "../components/Movement.h"
 #include <cmath>
@@ -21,29 +22,23 @@ namespace ECS {
         explicit MovementSystem(World* ecsWorld) : world(ecsWorld) {}
         
         void update(float deltaTime) override {
-            // Get all movement components
-            const auto& movements = world->getAllComponents<Movement>();
-            
-            for (const auto& [entityID, movement] : movements) {
-                if (!movement || !movement->isMoving) {
-                    continue;
-                }
-                
-                // Get the position component for this entity
-                auto* position = world->getComponent<PositionComponent>(entityID);
-                if (!position) {
-                    continue; // Entity has movement but no position
-                }
-                
-                // Update position based on movement
-                updateEntityPosition(entityID, position, movement.get(), deltaTime);
-            }
+            // Reads both columns together; no per-entity lookups with archetypes
+            world->forEach<Movement, PositionComponent>(
+                [this, deltaTime](EntityID entityID, Movement& movement, PositionComponent& position) {
+                    if (movement.isMoving) {
+                        updateEntityPosition(entityID, &position, &movement, deltaTime);
+                    }
+                });
         }
         
         const char* getName() const override {
             return "MovementSystem";
         }
         
+        void declareAccess(SystemAccess& access) const override {
+            access.writes<Movement>().writes<PositionComponent>();
+        }
+        
     private:
         void updateEntityPosition(EntityID entityID, PositionComponent* position, 
                                 Movement* movement, float deltaTime) {
@@ -56,9 +51,7 @@ namespace ECS {
                 // Arrived at target
                 position->x = movement->targetX;
                 position->y = movement->targetY;
-                movement->isMoving = false;
-                movement->phase = MovementPhase::ARRIVING;
-                movement->phaseTimer = 0.0f;
+                MovementManager::setPhase(*world, entityID, *movement, MovementPhase::ARRIVING);
                 return;
             }
             
@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+
+/**
+ * @brief Turns variable real frame times into a whole number of fixed steps.
+ *
+ * Real time is banked in an accumulator and paid out one fixed step at a
+ * time, so the simulation always advances by the same amount per step no
+ * matter how fast or unevenly frames arrive. At most maxStepsPerFrame
+ * steps are paid out per call; time beyond that is dropped rather than
+ * carried over, so a long stall (debugger, window drag, slow tick) makes
+ * the simulation fall behind real time instead of spiralling into ever
+ * longer catch-up frames.
+ */
+class FixedTimestep {
+public:
+    /**
+     * @param stepSeconds Real seconds covered by one step.
+     * @param maxStepsPerFrame Catch-up limit for a single advance() call.
+     */
+    explicit FixedTimestep(float stepSeconds = 1.0f / 60.0f, int maxStepsPerFrame = 5)
+        : stepSeconds(stepSeconds), maxStepsPerFrame(std::max(maxStepsPerFrame, 1)) {}
+
+    /**
+     * @brief Banks frameSeconds of real time.
+     * @return int Number of fixed steps to run now.
+     */
+    int advance(float frameSeconds) {
+        accumulator += std::max(frameSeconds, 0.0f);
+        int steps = static_cast<int>(accumulator / stepSeconds);
+        if (steps > maxStepsPerFrame) {
+            droppedSeconds += accumulator - maxStepsPerFrame * static_cast<double>(stepSeconds);
+            steps = maxStepsPerFrame;
+            accumulator = 0.0;
+        } else {
+            accumulator -= steps * static_cast<double>(stepSeconds);
+        }
+        return steps;
+    }
+
+    /**
+     * @brief How far real time is into the next step, from 0 to 1.
+     */
+    float getAlpha() const { return static_cast<float>(accumulator / stepSeconds); }
+
+    float getStepSeconds() const { return stepSeconds; }
+    int getMaxStepsPerFrame() const { return maxStepsPerFrame; }
+
+    /**
+     * @brief Real time banked towards the next step; saved with the simulation.
+     */
+    double getAccumulator() const { return accumulator; }
+    void setAccumulator(double seconds) { accumulator = seconds; }
+
+    /**
+     * @brief Real time discarded by the catch-up limit so far.
+     */
+    double getDroppedSeconds() const { return droppedSeconds; }
+
+    void reset() {
+        accumulator = 0.0;
+        droppedSeconds = 0.0;
+    }
+
+private:
+    float stepSeconds;
+    int maxStepsPerFrame;
+    double accumulator = 0.0;
+    double droppedSeconds = 0.0;
+};
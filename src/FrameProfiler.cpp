@@ -0,0 +1,77 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <ostream>
+
+FrameProfiler::SectionId FrameProfiler::addSection(const std::string& name) {
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (sections[i].name == name) return static_cast<SectionId>(i);
+    }
+
+    Section section;
+    section.name = name;
+    section.samples.resize(WINDOW, 0.0f);
+    sections.push_back(std::move(section));
+    return static_cast<SectionId>(sections.size() - 1);
+}
+
+void FrameProfiler::record(SectionId id, std::chrono::steady_clock::duration elapsed) {
+    if (id < 0 || static_cast<size_t>(id) >= sections.size()) return;
+
+    Section& section = sections[id];
+    section.samples[section.next] = std::chrono::duration<float, std::milli>(elapsed).count();
+    section.next = (section.next + 1) % WINDOW;
+    section.count = std::min(section.count + 1, WINDOW);
+}
+
+void FrameProfiler::summarize(std::vector<Stats>& out) const {
+    out.resize(sections.size());
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const Section& section = sections[i];
+        Stats& stats = out[i];
+        stats.name = section.name;
+        stats.samples = section.count;
+
+        if (section.count == 0) {
+            stats.minMs = stats.meanMs = stats.p99Ms = stats.lastMs = 0.0f;
+            continue;
+        }
+
+        // Samples live in [0, count) until the ring has wrapped once
+        scratch.assign(section.samples.begin(), section.samples.begin() + section.count);
+
+        float sum = 0.0f;
+        float minimum = scratch[0];
+        for (float sample : scratch) {
+            sum += sample;
+            minimum = std::min(minimum, sample);
+        }
+
+        size_t p99Index = (section.count * 99) / 100;
+        if (p99Index >= section.count) p99Index = section.count - 1;
+        std::nth_element(scratch.begin(), scratch.begin() + p99Index, scratch.end());
+
+        stats.minMs = minimum;
+        stats.meanMs = sum / static_cast<float>(section.count);
+        stats.p99Ms = scratch[p99Index];
+        stats.lastMs = section.samples[(section.next + WINDOW - 1) % WINDOW];
+    }
+}
+
+void FrameProfiler::reset() {
+    for (Section& section : sections) {
+        section.next = 0;
+        section.count = 0;
+    }
+}
+
+void FrameProfiler::writeCsv(std::ostream& out, const std::string& group,
+                             const std::vector<Stats>& stats, bool header) {
+    if (header) {
+        out << "group,section,samples,min_ms,mean_ms,p99_ms,last_ms\n";
+    }
+    for (const Stats& s : stats) {
+        out << group << ',' << s.name << ',' << s.samples << ','
+            << s.minMs << ',' << s.meanMs << ',' << s.p99Ms << ',' << s.lastMs << '\n';
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Scoped high-resolution timers with rolling per-section statistics.
+ *
+ * Sections are registered once by name and then timed with Scope objects.
+ * Each section keeps the last WINDOW samples in a ring, from which
+ * min/mean/p99 are computed on demand.
+ *
+ * A profiler is owned by a single thread: the simulation and the renderer
+ * each have their own. Only the enabled flag may be flipped from another
+ * thread. While disabled, a Scope costs one relaxed atomic load and no
+ * clock reads.
+ */
+class FrameProfiler {
+public:
+    using SectionId = int;
+    static constexpr size_t WINDOW = 240;
+
+    struct Stats {
+        std::string name;
+        size_t samples = 0;
+        float minMs = 0.0f;
+        float meanMs = 0.0f;
+        float p99Ms = 0.0f;
+        float lastMs = 0.0f;
+    };
+
+    /**
+     * @brief Times the enclosing scope into a section.
+     *
+     * A null profiler is allowed and records nothing.
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler* profiler, SectionId section)
+            : profiler(profiler && profiler->isEnabled() ? profiler : nullptr), section(section)
+        {
+            if (this->profiler) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Scope() {
+            if (profiler) {
+                profiler->record(section, std::chrono::steady_clock::now() - start);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler* profiler;
+        SectionId section;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief Registers a section, or returns the existing one with that name.
+     */
+    SectionId addSection(const std::string& name);
+
+    void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void record(SectionId section, std::chrono::steady_clock::duration elapsed);
+
+    /**
+     * @brief Writes one Stats entry per section into out, reusing its storage.
+     */
+    void summarize(std::vector<Stats>& out) const;
+
+    /**
+     * @brief Discards all recorded samples.
+     */
+    void reset();
+
+    /**
+     * @brief Writes stats as CSV rows tagged with a group name (e.g. "sim").
+     * @param header Whether to write the column header first.
+     */
+    static void writeCsv(std::ostream& out, const std::string& group,
+                         const std::vector<Stats>& stats, bool header);
+
+private:
+    struct Section {
+        std::string name;
+        std::vector<float> samples;  // Milliseconds, ring of WINDOW entries
+        size_t next = 0;
+        size_t count = 0;
+    };
+
+    std::vector<Section> sections;
+    std::atomic<bool> enabled{false};
+    mutable std::vector<float> scratch;
+};
@@ -31,6 +31,8 @@ struct Cell {
 
 struct Zone {
     int x, y, width, height;
+
+    bool operator==(const Zone&) const = default;
 };
 
 class Grid {
@@ -50,6 +52,21 @@ public:
     int getWidth() const { return width; }
     int getHeight() const { return height; }
 
+    /**
+     * @brief Overwrites this grid with other's size, cells and zones, reusing this grid's buffers.
+     *
+     * Zones are only reassigned when they differ, since they are normally
+     * fixed after loading; references into zones stay valid in that case.
+     */
+    void copyStateFrom(const Grid& other) {
+        width = other.width;
+        height = other.height;
+        cells = other.cells;
+        if (zones != other.zones) {
+            zones = other.zones;
+        }
+    }
+
     /**
      * @brief Dumps the grid to console in ASCII format
      * Shows obstacles as '#' and movement costs as numbers
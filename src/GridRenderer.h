@@ -1,9 +1,12 @@
 #pragma once
 
 #include <SDL3/SDL.h>
-#include <SDL3_ttf/SDL_ttf.h>
 #include "Grid.h"
-#include "HomeManager.h"  // Add this include
+#include "TextRenderer.h"
+#include "Camera.h"
+#include <cmath>
+#include <string>
+#include <unordered_map>
 
 namespace GridRenderer
 {
@@ -13,21 +16,30 @@ namespace GridRenderer
      * @param renderer The SDL_Renderer to render to.
      * @param grid The Grid object containing cell data.
      * @param cellSize The size of each cell in pixels.
+     * @param camera The camera; only tiles and zones inside its view are drawn.
      * @param editMode If true, enables edit mode features like grid lines and hover effect.
      * @param showZones If true, shows zone outlines and indicators.
      */
-    void render(SDL_Renderer *renderer, const Grid &grid, int cellSize, bool editMode = false, bool showZones = true)
+    void render(SDL_Renderer *renderer, const Grid &grid, int cellSize, const Camera &camera, bool editMode = false, bool showZones = true)
     {
-        // First pass: Render all tiles (same as before)
-        for (int y = 0; y < grid.getHeight(); ++y)
+        camera.beginWorld(renderer);
+        const float offsetX = camera.getX();
+        const float offsetY = camera.getY();
+
+        // First pass: Render only the tiles that overlap the viewport
+        int minTileX, minTileY, maxTileX, maxTileY;
+        camera.getVisibleTileRange(cellSize, grid.getWidth(), grid.getHeight(),
+                                   minTileX, minTileY, maxTileX, maxTileY);
+
+        for (int y = minTileY; y < maxTileY; ++y)
         {
-            for (int x = 0; x < grid.getWidth(); ++x)
+            for (int x = minTileX; x < maxTileX; ++x)
             {
                 const Cell &cell = grid.at(x, y);
 
                 SDL_FRect rect = {
-                    static_cast<float>(x * cellSize),
-                    static_cast<float>(y * cellSize),
+                    x * cellSize - offsetX,
+                    y * cellSize - offsetY,
                     static_cast<float>(cellSize),
                     static_cast<float>(cellSize)};
 
@@ -77,6 +89,12 @@ namespace GridRenderer
                     static_cast<float>(zone.width * cellSize),
                     static_cast<float>(zone.height * cellSize)};
 
+                if (!camera.isVisible({zoneRect.x - 3, zoneRect.y - 3, zoneRect.w + 6, zoneRect.h + 6}))
+                    continue;
+
+                zoneRect.x -= offsetX;
+                zoneRect.y -= offsetY;
+
                 // Draw thick outline (3 pixels)
                 for (int thickness = 0; thickness < 3; ++thickness)
                 {
@@ -92,10 +110,14 @@ namespace GridRenderer
             // Third pass: Draw zone indicators with NPC home assignments
             for (const auto &[zoneName, zone] : grid.zones)
             {
+                if (!camera.isVisible({static_cast<float>(zone.x * cellSize), static_cast<float>(zone.y * cellSize),
+                                       static_cast<float>(zone.width * cellSize), static_cast<float>(zone.height * cellSize)}))
+                    continue;
+
                 // Draw a small colored square in the top-left corner of each zone
                 SDL_FRect labelRect = {
-                    static_cast<float>(zone.x * cellSize + 2),
-                    static_cast<float>(zone.y * cellSize + 2),
+                    zone.x * cellSize + 2 - offsetX,
+                    zone.y * cellSize + 2 - offsetY,
                     static_cast<float>(cellSize / 3),
                     static_cast<float>(cellSize / 3)};
 
@@ -156,8 +178,8 @@ namespace GridRenderer
                     // Draw a small number to indicate which NPC lives here
                     // This is a simple visual indicator - for full text you'd need font rendering
                     SDL_FRect numberRect = {
-                        static_cast<float>(zone.x * cellSize + zone.width * cellSize - cellSize/4),
-                        static_cast<float>(zone.y * cellSize + 2),
+                        zone.x * cellSize + zone.width * cellSize - cellSize/4 - offsetX,
+                        zone.y * cellSize + 2 - offsetY,
                         static_cast<float>(cellSize / 6),
                         static_cast<float>(cellSize / 6)};
                     
@@ -173,87 +195,80 @@ namespace GridRenderer
             // Show mouse hover highlight
             float mouseX, mouseY;
             SDL_GetMouseState(&mouseX, &mouseY);
-            int hoverGridX = static_cast<int>(mouseX / cellSize);
-            int hoverGridY = static_cast<int>(mouseY / cellSize);
+            SDL_FPoint mouseWorld = camera.screenToWorld(mouseX, mouseY);
+            int hoverGridX = static_cast<int>(std::floor(mouseWorld.x / cellSize));
+            int hoverGridY = static_cast<int>(std::floor(mouseWorld.y / cellSize));
 
             if (hoverGridX >= 0 && hoverGridX < grid.getWidth() &&
                 hoverGridY >= 0 && hoverGridY < grid.getHeight())
             {
                 SDL_SetRenderDrawColor(renderer, 255, 255, 0, 128); // Yellow highlight
                 SDL_FRect hoverRect = {
-                    static_cast<float>(hoverGridX * cellSize),
-                    static_cast<float>(hoverGridY * cellSize),
+                    hoverGridX * cellSize - offsetX,
+                    hoverGridY * cellSize - offsetY,
                     static_cast<float>(cellSize),
                     static_cast<float>(cellSize)};
                 SDL_RenderFillRect(renderer, &hoverRect);
             }
         }
+
+        camera.endWorld(renderer);
     }
 
     /**
      * Enhanced version that can render zone labels with NPC home assignments
      */
-    void renderWithLabels(SDL_Renderer *renderer, const Grid &grid, int cellSize, TTF_Font *font, bool editMode = false, bool showZones = true, HomeManager* homeManager = nullptr)
+    void renderWithLabels(SDL_Renderer *renderer, const Grid &grid, int cellSize, const Camera &camera, TextRenderer *text, bool editMode = false, bool showZones = true,
+                          const std::unordered_map<std::string, int>* homeResidents = nullptr)
     {
         // First render everything as normal
-        render(renderer, grid, cellSize, editMode, showZones);
+        render(renderer, grid, cellSize, camera, editMode, showZones);
 
-        // Then add text labels if font is provided and zones are visible
-        if (font && showZones)
+        // Then add text labels if a text renderer is provided and zones are visible
+        if (text && showZones)
         {
             SDL_Color textColor = {255, 255, 255, 255};   // White text
             SDL_Color bgColor = {0, 0, 0, 180};           // Semi-transparent black background
 
             for (const auto &[zoneName, zone] : grid.zones)
             {
+                if (!camera.isVisible({static_cast<float>(zone.x * cellSize), static_cast<float>(zone.y * cellSize),
+                                       static_cast<float>(zone.width * cellSize), static_cast<float>(zone.height * cellSize)}))
+                    continue;
+
                 std::string displayText = zoneName;
                 
                 // For homes, add the NPC name if assigned
-                if (homeManager && zoneName.find("Home") != std::string::npos) {
-                    int residentId = homeManager->getHomeResident(zoneName);
-                    if (residentId != -1) {
-                        displayText += "\n(NPC " + std::to_string(residentId) + ")";
+                if (homeResidents && zoneName.find("Home") != std::string::npos) {
+                    auto resident = homeResidents->find(zoneName);
+                    if (resident != homeResidents->end()) {
+                        displayText += "\n(NPC " + std::to_string(resident->second) + ")";
                     } else {
                         displayText += "\n(Vacant)";
                     }
                 }
 
-                // Create text surface
-                SDL_Surface *textSurface = TTF_RenderText_Solid(font, displayText.c_str(), displayText.length(), textColor);
-                if (textSurface)
-                {
-                    SDL_Texture *textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                    if (textTexture)
-                    {
-                        // Position label in center of zone
-                        float labelX = zone.x * cellSize + (zone.width * cellSize - textSurface->w) / 2.0f;
-                        float labelY = zone.y * cellSize + (zone.height * cellSize - textSurface->h) / 2.0f;
-
-                        // Draw background rectangle
-                        SDL_FRect bgRect = {
-                            labelX - 4,
-                            labelY - 2,
-                            static_cast<float>(textSurface->w + 8),
-                            static_cast<float>(textSurface->h + 4)};
-
-                        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                        SDL_SetRenderDrawColor(renderer, bgColor.r, bgColor.g, bgColor.b, bgColor.a);
-                        SDL_RenderFillRect(renderer, &bgRect);
+                SDL_FPoint size = text->measure(displayText);
 
-                        // Draw text
-                        SDL_FRect textRect = {
-                            labelX,
-                            labelY,
-                            static_cast<float>(textSurface->w),
-                            static_cast<float>(textSurface->h)};
+                // Position label in center of zone (labels stay at screen scale)
+                SDL_FPoint center = camera.worldToScreen((zone.x + zone.width / 2.0f) * cellSize,
+                                                         (zone.y + zone.height / 2.0f) * cellSize);
+                float labelX = center.x - size.x / 2.0f;
+                float labelY = center.y - size.y / 2.0f;
 
-                        SDL_RenderTexture(renderer, textTexture, nullptr, &textRect);
+                // Background rectangle, batched together with the glyphs
+                SDL_FRect bgRect = {
+                    labelX - 4,
+                    labelY - 2,
+                    size.x + 8,
+                    size.y + 4};
 
-                        SDL_DestroyTexture(textTexture);
-                    }
-                    SDL_DestroySurface(textSurface);
-                }
+                text->addRect(bgRect, bgColor);
+                text->addText(displayText, labelX, labelY, textColor);
             }
+
+            // Labels must land before entities are drawn over the map
+            text->flush();
         }
     }
 }
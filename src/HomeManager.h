@@ -1,5 +1,6 @@
 #pragma once
 
+#include <iostream>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -16,6 +17,7 @@ private:
     std::unordered_map<int, std::string> npcToHome; // NPC ID -> Home zone name
     std::unordered_map<std::string, int> homeToNpc; // Home zone name -> NPC ID
     std::vector<std::string> availableHomes;
+    std::ostream* log = &std::cout;
 
 public:
     HomeManager() {
@@ -25,6 +27,11 @@ public:
         };
     }
 
+    /**
+     * Sets where assignments are reported; null keeps them silent
+     */
+    void setLog(std::ostream* stream) { log = stream; }
+
     /**
      * Assigns a home to an NPC
      */
@@ -40,12 +47,12 @@ public:
                 // This home is available
                 npcToHome[npcId] = homeName;
                 homeToNpc[homeName] = npcId;
-                std::cout << "Assigned " << npcName << " (ID: " << npcId << ") to " << homeName << std::endl;
+                if (log) *log << "Assigned " << npcName << " (ID: " << npcId << ") to " << homeName << std::endl;
                 return true;
             }
         }
 
-        std::cout << "Warning: No available homes for " << npcName << " (ID: " << npcId << ")" << std::endl;
+        if (log) *log << "Warning: No available homes for " << npcName << " (ID: " << npcId << ")" << std::endl;
         return false; // No available homes
     }
 
@@ -65,6 +72,13 @@ public:
         return (it != homeToNpc.end()) ? it->second : -1;
     }
 
+    /**
+     * Gets the NPC ID living in each assigned home, keyed by home zone name
+     */
+    const std::unordered_map<std::string, int>& getHomeResidents() const {
+        return homeToNpc;
+    }
+
     /**
      * Gets all home assignments
      */
@@ -76,6 +90,18 @@ public:
         return assignments;
     }
 
+    /**
+     * Replaces every assignment, e.g. when loading a snapshot
+     */
+    void restoreAssignments(const std::vector<HomeAssignment>& assignments) {
+        npcToHome.clear();
+        homeToNpc.clear();
+        for (const auto& assignment : assignments) {
+            npcToHome[assignment.npcId] = assignment.zoneName;
+            homeToNpc[assignment.zoneName] = assignment.npcId;
+        }
+    }
+
     /**
      * Removes an NPC's home assignment
      */
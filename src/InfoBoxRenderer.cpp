@@ -0,0 +1,28 @@
+#include "InfoBoxRenderer.h"
+
+namespace InfoBoxRenderer
+{
+    void render(TextRenderer &text, const std::vector<RenderSnapshot::InfoBoxView> &infoBoxes, const Camera &camera)
+    {
+        SDL_Color textColor = { 0, 0, 0, 255 };             // Black
+        SDL_Color boxColor = { 255, 255, 255, 127 };            // White with transparency
+
+        for (const auto &infoBox : infoBoxes)
+        {
+            // Calculate total dimensions needed (handles multi-line text)
+            SDL_FPoint size = text.measure(infoBox.text);
+            SDL_FPoint anchor = camera.worldToScreen(infoBox.x, infoBox.y);
+
+            // Create a background box with padding
+            SDL_FRect boxRect;
+            boxRect.w = size.x + 8; // 4px padding on each side
+            boxRect.h = size.y + 4; // 2px padding on top/bottom
+            boxRect.x = anchor.x - (boxRect.w / 2); // Center the box
+            boxRect.y = anchor.y - 32 * camera.getZoom() - boxRect.h;  // Position above the entity
+
+            // Queue the background box and the text in the shared batch
+            text.addRect(boxRect, boxColor);
+            text.addText(infoBox.text, boxRect.x + 4, boxRect.y + 2, textColor);
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+#include "RenderSnapshot.h"
+#include "TextRenderer.h"
+#include "Camera.h"
+
+namespace InfoBoxRenderer
+{
+    /**
+     * Queues the info boxes captured in a snapshot into the text batch.
+     *
+     * Touches no manager state, so it is safe to call from the render thread.
+     *
+     * @param text The text batch to draw into.
+     * @param infoBoxes Info boxes of the visible entities.
+     * @param camera The camera used to place each box above its entity.
+     */
+    void render(TextRenderer &text, const std::vector<RenderSnapshot::InfoBoxView> &infoBoxes, const Camera &camera);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Small seeded random number generator (SplitMix64) owned by one simulation.
+ *
+ * Replaces the global rand(): each simulation draws from its own stream,
+ * so runs with the same seed repeat exactly on every platform and
+ * simulations running side by side on different threads share nothing.
+ * The whole state is one integer; snapshots and checkpoints save it so a
+ * resumed run draws the same numbers as the original.
+ */
+class Random {
+public:
+    explicit Random(std::uint64_t seed = 1) : state(seed) {}
+
+    void seed(std::uint64_t value) { state = value; }
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Uniform integer in [0, bound); bound must be positive.
+     */
+    std::uint64_t below(std::uint64_t bound) {
+        return next() % bound;
+    }
+
+    std::uint64_t getState() const { return state; }
+    void setState(std::uint64_t value) { state = value; }
+
+private:
+    std::uint64_t state;
+};
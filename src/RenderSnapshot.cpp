@@ -0,0 +1,43 @@
+#include "RenderSnapshot.h"
+#include <algorithm>
+
+void SnapshotInterpolator::interpolate(const RenderSnapshot& snapshot, TimePoint now,
+                                       std::vector<RenderSnapshot::EntityView>& entities,
+                                       std::vector<RenderSnapshot::InfoBoxView>& infoBoxes) {
+    // A new state: the current one becomes the previous one
+    if (snapshot.tick != currentTick) {
+        previous.swap(current);
+        current.clear();
+        for (const auto& entity : snapshot.entities) {
+            current[entity.uid] = {entity.x, entity.y};
+        }
+        previousPublishedAt = currentPublishedAt;
+        currentPublishedAt = snapshot.publishedAt;
+        currentTick = snapshot.tick;
+    }
+
+    alpha = 1.0f;
+    auto interval = currentPublishedAt - previousPublishedAt;
+    if (!previous.empty() && interval.count() > 0) {
+        float elapsed = std::chrono::duration<float>(now - currentPublishedAt).count();
+        alpha = std::clamp(elapsed / std::chrono::duration<float>(interval).count(), 0.0f, 1.0f);
+    }
+
+    entities = snapshot.entities;
+    for (auto& entity : entities) {
+        blend(entity.uid, entity.x, entity.y);
+    }
+    infoBoxes = snapshot.infoBoxes;
+    for (auto& infoBox : infoBoxes) {
+        blend(infoBox.uid, infoBox.x, infoBox.y);
+    }
+}
+
+void SnapshotInterpolator::blend(unsigned int uid, float& x, float& y) const {
+    auto it = previous.find(uid);
+    if (it == previous.end()) {
+        return;
+    }
+    x = it->second.x + (x - it->second.x) * alpha;
+    y = it->second.y + (y - it->second.y) * alpha;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Grid.h"
+#include "FrameProfiler.h"
+
+/**
+ * @brief Immutable view of the simulation handed from the sim thread to the renderer.
+ *
+ * The simulation fills one of these after each batch of fixed steps and
+ * publishes it through a TripleBuffer. The render thread only ever reads the snapshot, never the
+ * live managers, so the two threads share no mutable state.
+ */
+struct RenderSnapshot {
+    struct EntityView {
+        unsigned int uid;
+        float x, y;
+    };
+
+    struct InfoBoxView {
+        unsigned int uid; // Entity the box is attached to
+        float x, y;
+        std::string text;
+    };
+
+    std::uint64_t tick = 0;
+    std::chrono::steady_clock::time_point publishedAt; // When the simulation finished this state
+
+    // Entities inside the requested view region
+    std::vector<EntityView> entities;
+    std::vector<InfoBoxView> infoBoxes;
+
+    std::string clockText;
+    bool paused = false;
+
+    // Copy of the grid, replaced only when the map is edited
+    std::shared_ptr<const Grid> grid;
+
+    // NPC living in each home zone, replaced only when homes are reassigned
+    std::shared_ptr<const std::unordered_map<std::string, int>> homeResidents;
+
+    // Simulation timing stats; empty unless profiling is enabled
+    std::vector<FrameProfiler::Stats> simTimings;
+};
+
+/**
+ * @brief World-space region the renderer wants included in the next snapshot.
+ *
+ * Written by the render thread from its camera and read by the sim thread
+ * when it builds a snapshot. The fields are independent atomics; a torn
+ * read only shifts the culling rectangle for one tick.
+ */
+struct SnapshotViewRequest {
+    std::atomic<float> x{0.0f};
+    std::atomic<float> y{0.0f};
+    std::atomic<float> width{0.0f};
+    std::atomic<float> height{0.0f};
+
+    void set(float newX, float newY, float newWidth, float newHeight) {
+        x.store(newX, std::memory_order_relaxed);
+        y.store(newY, std::memory_order_relaxed);
+        width.store(newWidth, std::memory_order_relaxed);
+        height.store(newHeight, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Draws entities between the two most recent snapshots the renderer saw.
+ *
+ * The simulation advances in fixed steps that rarely line up with render
+ * frames, so drawing the latest state as-is makes motion judder. Instead
+ * each entity is placed between its position in the previous and the
+ * current snapshot, by how far real time has moved through the interval
+ * between their publish times. Motion is smooth at any frame rate, at the
+ * cost of showing the world up to one interval late. Entities missing
+ * from the previous snapshot are drawn where they are now.
+ */
+class SnapshotInterpolator {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /**
+     * @brief Copies snapshot's entities and info boxes, moved to where they are at now.
+     */
+    void interpolate(const RenderSnapshot& snapshot, TimePoint now,
+                     std::vector<RenderSnapshot::EntityView>& entities,
+                     std::vector<RenderSnapshot::InfoBoxView>& infoBoxes);
+
+    /**
+     * @brief Blend used by the last interpolate(): 0 is the previous snapshot, 1 the current one.
+     */
+    float getAlpha() const { return alpha; }
+
+private:
+    struct Point {
+        float x, y;
+    };
+
+    std::unordered_map<unsigned int, Point> previous;
+    std::unordered_map<unsigned int, Point> current;
+    std::uint64_t currentTick = 0;
+    TimePoint previousPublishedAt;
+    TimePoint currentPublishedAt;
+    float alpha = 1.0f;
+
+    void blend(unsigned int uid, float& x, float& y) const;
+};
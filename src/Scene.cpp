@@ -1,41 +1,131 @@
 #include "Scene.h"
 
-#include "ECS/DescriptionComponentManager.h"
-#include "ECS/ControllerManager.h"
-#include "ECS/MovementManager.h"
-#include "./ECS/AIManager.h"
-#include "./ECS/InfoBoxManager.h" // <-- Add include
+#include "./ECS/components/AIState.h"
+#include "./ECS/components/Controller.h"
+#include "./ECS/components/DescriptionComponent.h"
+#include "./ECS/components/InfoBoxComponent.h"
+#include "./ECS/components/Movement.h"
+#include "./ECS/components/PositionComponent.h"
+#include "./ECS/components/RoleTags.h"
 
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 
-bool Scene::loadFromFile(
-    const std::string &filename,
-    PositionManager *posManager,
-    RenderableManager *renderManager,
-    DescriptionComponentManager *descManager,
-    ControllerManager *controllerManager,
-    MovementManager *moveManager,
-    AIManager *aiManager,
-    InfoBoxManager *infoBoxManager,    Uint32 cellSize)
+namespace
 {
+    /**
+     * @brief Turns an entity block's component keys into component templates.
+     */
+    ECS::Prefab buildPrefab(const nlohmann::json &data)
+    {
+        ECS::Prefab prefab;
 
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open scene file " << filename << std::endl;
-        return false;
+        // Description
+        if (data.contains("description"))
+        {
+            std::string name = data["description"].value("name", "");
+            std::string longDesc = data["description"].value("long", "");
+            prefab.set(DescriptionComponent(name, longDesc));
+        }
+
+        // Position
+        if (data.contains("position"))
+        {
+            prefab.set(PositionComponent(data["position"].value("x", 0.0f),
+                                         data["position"].value("y", 0.0f)));
+        }
+
+        // Controller
+        if (data.contains("controller"))
+        {
+            std::string controllerType = data["controller"].value("type", "unknown");
+            // The only string compare for roles; everything later tests tag bits
+            if (controllerType == "player")
+            {
+                prefab.set(Controller(controllerType)).tag<PlayerTag>();
+            }
+            else if (controllerType == "guardian")
+            {
+                prefab.set(Controller(controllerType)).tag<GuardianTag>();
+            }
+            else if (controllerType == "citizen")
+            {
+                prefab.set(Controller(controllerType)).tag<CitizenTag>();
+            }
+        }
+
+        // Movement (for player/AI target-based movement)
+        if (data.contains("movement"))
+        {
+            prefab.set(Movement(data["movement"].value("speed", 0.0f)));
+        }
+
+        // --- Add AI State Component ---
+        if (data.contains("ai_state"))
+        {
+            prefab.set(AIState());
+            // If an entity has AI, it gets an infobox with their name.
+            std::string name = data.contains("description") ? data["description"].value("name", "Unknown") : "Unknown";
+            prefab.set(InfoBoxComponent(name + "\nIdle"));
+        }
+
+        return prefab;
     }
 
-    nlohmann::json j;
-    try
+    bool readShape(const nlohmann::json &data, ShapeDescription &shape)
     {
-        j = nlohmann::json::parse(file, nullptr, true, true);
+        if (!data.contains("shape"))
+        {
+            return false;
+        }
+        const auto &shape_data = data["shape"];
+        const auto &color_data = shape_data["color"];
+
+        shape.type = shape_data.value("type", "");
+        shape.r = (unsigned char)color_data[0].get<int>();
+        shape.g = (unsigned char)color_data[1].get<int>();
+        shape.b = (unsigned char)color_data[2].get<int>();
+        shape.a = (unsigned char)color_data[3].get<int>();
+        return true;
     }
-    catch (const nlohmann::json::parse_error &e)
+
+    /**
+     * @brief Parses a scene file, reporting failures on std::cerr.
+     */
+    bool readSceneFile(const std::string &filename, nlohmann::json &j)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open scene file " << filename << std::endl;
+            return false;
+        }
+
+        try
+        {
+            j = nlohmann::json::parse(file, nullptr, true, true);
+        }
+        catch (const nlohmann::json::parse_error &e)
+        {
+            std::cerr << "Error parsing scene file: " << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+bool Scene::loadFromFile(
+    const std::string &filename,
+    ECS::World &world,
+    const ShapeCallback &onShape,
+    unsigned int cellSize)
+{
+    nlohmann::json j;
+    if (!readSceneFile(filename, j))
     {
-        std::cerr << "Error parsing scene file: " << e.what() << std::endl;
         return false;
     }
 
@@ -46,89 +136,178 @@ bool Scene::loadFromFile(
         return false;
     }
 
+    // Prefabs first, so entities and spawns below can refer to them
+    if (j.contains("prefabs"))
+    {
+        for (const auto &[name, definition] : j["prefabs"].items())
+        {
+            definePrefab(name, definition);
+        }
+    }
+
     // Iterate over the array associated with the "entities" key
     for (const auto &entity_data : j["entities"])
     {
         if (!entity_data.contains("id"))
             continue;
-        unsigned int uid = entity_data["id"];
 
-        // Description
-        if (entity_data.contains("description"))
+        // An entity naming a prefab starts from its block; its own keys win
+        nlohmann::json data = entity_data;
+        if (entity_data.contains("prefab"))
         {
-            if (descManager) {
-                std::string name = entity_data["description"].value("name", "");
-                std::string longDesc = entity_data["description"].value("long", "");
-                descManager->create(uid, name, longDesc);
+            std::string prefabName = entity_data.value("prefab", "");
+            auto it = prefabs.find(prefabName);
+            if (it == prefabs.end())
+            {
+                if (log)
+                {
+                    *log << "Error: unknown prefab '" << prefabName << "' in " << filename << std::endl;
+                }
+                continue;
             }
+            data = it->second.definition;
+            data.merge_patch(entity_data);
         }
 
-        // Position
-        if (entity_data.contains("position"))
+        ECS::EntityID entity = buildPrefab(data).instantiate(world);
+        if (!ECS::isValidEntity(entity))
         {
-            if (posManager)
+            if (log)
             {
-                posManager->create(uid,
-                                   entity_data["position"].value("x", 0.0f),
-                                   entity_data["position"].value("y", 0.0f));
+                *log << "Warning: entity limit reached; skipping the rest of " << filename << std::endl;
             }
+            return true;
+        }
+        if (log && data.contains("controller"))
+        {
+            *log << "Creating controller for entity " << entity << " with type: "
+                      << data["controller"].value("type", "unknown") << std::endl;
         }
 
-        // Controller
-        if (entity_data.contains("controller"))
+        // Shape/Renderable
+        ShapeDescription shape;
+        if (onShape && readShape(data, shape))
         {
-            if (controllerManager)
-            {
-                // Get the controller type from the JSON data
-                std::string controllerType = entity_data["controller"].value("type", "unknown");
-                // Pass the type to the create method
-                controllerManager->create(uid, controllerType);
-            }
+            shape.x = data["position"].value("x", 0.0f);
+            shape.y = data["position"].value("y", 0.0f);
+            onShape(entity, shape);
         }
+    }
 
-        // Movement (for player/AI target-based movement)
-        if (entity_data.contains("movement"))
+    // Bulk spawns: { "prefab": name, "count": n, "placement": { "x", "y", "columns", "spacing_x", "spacing_y" } }
+    if (j.contains("spawn"))
+    {
+        for (const auto &spawn_data : j["spawn"])
         {
-            if (moveManager)
+            SpawnPlacement placement;
+            if (spawn_data.contains("placement"))
             {
-                moveManager->create(uid, entity_data["movement"].value("speed", 0.0f));
+                const auto &placement_data = spawn_data["placement"];
+                placement.x = placement_data.value("x", placement.x);
+                placement.y = placement_data.value("y", placement.y);
+                placement.columns = placement_data.value("columns", placement.columns);
+                placement.spacingX = placement_data.value("spacing_x", placement.spacingX);
+                placement.spacingY = placement_data.value("spacing_y", placement.spacingY);
+            }
+            std::string prefabName = spawn_data.value("prefab", "");
+            int count = spawn_data.value("count", 0);
+            if (count > 0 && !spawnBatch(world, prefabName, static_cast<size_t>(count), placement, onShape))
+            {
+                if (log)
+                {
+                    *log << "Error: unknown prefab '" << prefabName << "' in " << filename << std::endl;
+                }
             }
         }
+    }
 
-        // --- Add AI State Component ---
-        if (entity_data.contains("ai_state"))
+    return true;
+}
+
+bool Scene::loadPrefabsFromFile(const std::string &filename)
+{
+    nlohmann::json j;
+    if (!readSceneFile(filename, j))
+    {
+        return false;
+    }
+    if (j.contains("prefabs"))
+    {
+        for (const auto &[name, definition] : j["prefabs"].items())
         {
-            if (aiManager)
-                aiManager->create(uid);
-            // If an entity has AI, it gets an infobox with their name.
-            if (infoBoxManager) {
-                std::string name = entity_data["description"].value("name", "Unknown");
-                infoBoxManager->create(uid, name + "\nIdle");
-            }
+            definePrefab(name, definition);
         }
+    }
+    return true;
+}
 
-        // Shape/Renderable
-        if (entity_data.contains("shape"))
+void Scene::definePrefab(const std::string &name, const nlohmann::json &definition)
+{
+    PrefabDefinition &entry = prefabs[name];
+    entry.definition = definition;
+    entry.prefab = buildPrefab(definition);
+    entry.hasShape = readShape(definition, entry.shape);
+    // Batches are always placed, so every instance needs a position
+    if (!entry.prefab.has<PositionComponent>())
+    {
+        entry.prefab.set(PositionComponent(0.0f, 0.0f));
+    }
+}
+
+const ECS::Prefab *Scene::findPrefab(const std::string &name) const
+{
+    auto it = prefabs.find(name);
+    return it != prefabs.end() ? &it->second.prefab : nullptr;
+}
+
+bool Scene::spawnBatch(ECS::World &world,
+                       const std::string &prefabName,
+                       size_t count,
+                       const SpawnPlacement &placement,
+                       const ShapeCallback &onShape,
+                       std::vector<ECS::EntityID> *spawned)
+{
+    auto it = prefabs.find(prefabName);
+    if (it == prefabs.end())
+    {
+        return false;
+    }
+    const PrefabDefinition &entry = it->second;
+
+    std::vector<ECS::EntityID> &out = spawned ? *spawned : spawnScratch;
+    if (!spawned)
+    {
+        out.clear();
+    }
+    size_t first = out.size();
+    size_t requested = count;
+    count = entry.prefab.spawnBatch(world, count, out);
+    if (log && count < requested)
+    {
+        *log << "Warning: entity limit reached; spawned " << count << " of " << requested
+             << " '" << prefabName << "'" << std::endl;
+    }
+
+    int columns = placement.columns;
+    if (columns <= 0)
+    {
+        columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    }
+
+    ShapeDescription shape = entry.shape;
+    for (size_t i = 0; i < count; ++i)
+    {
+        ECS::EntityID entity = out[first + i];
+        auto *position = world.getComponent<PositionComponent>(entity);
+        position->x = placement.x + static_cast<float>(i % columns) * placement.spacingX;
+        position->y = placement.y + static_cast<float>(i / columns) * placement.spacingY;
+
+        if (onShape && entry.hasShape)
         {
-            if (renderManager)
-            {
-                auto shape_data = entity_data["shape"];
-                auto color_data = shape_data["color"];
-                SDL_Color color = {
-                    (Uint8)color_data[0].get<int>(),
-                    (Uint8)color_data[1].get<int>(),
-                    (Uint8)color_data[2].get<int>(),
-                    (Uint8)color_data[3].get<int>()};
-
-                if (shape_data.value("type", "") == "circle") {
-                    renderManager->createCircle(uid, 
-                        entity_data["position"].value("x", 0.0f),
-                        entity_data["position"].value("y", 0.0f),
-                        color);
-                }
-            }
+            shape.x = position->x;
+            shape.y = position->y;
+            onShape(entity, shape);
         }
     }
-
     return true;
 }
@@ -1,34 +1,114 @@
 #pragma once
 
 #include "./ECS/Entity.h"
-#include "./ECS/PositionManager.h"
-#include "./ECS/RenderableManager.h"
-#include "./ECS/DescriptionComponentManager.h"
-#include "./ECS/ControllerManager.h"
-#include "./ECS/MovementManager.h"
-#include "./ECS/AIManager.h"
+#include "./ECS/World.h"
+#include "./ECS/Prefab.h"
 
 #include <vector>
 #include <memory>
 #include <string>
+#include <functional>
+#include <unordered_map>
 
 #include <nlohmann/json.hpp>
 #include <fstream>
+#include <iostream>
 
-class InfoBoxManager; // Forward declare
+/**
+ * @brief Renderer-independent description of an entity's shape from the scene file.
+ */
+struct ShapeDescription
+{
+    std::string type; // e.g. "circle"
+    float x, y;
+    unsigned char r, g, b, a;
+};
+
+/**
+ * @brief Where Scene::spawnBatch() places entities: row by row on a grid starting at (x, y).
+ */
+struct SpawnPlacement
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    int columns = 0; // 0 lays the batch out as a roughly square block
+    float spacingX = 32.0f;
+    float spacingY = 32.0f;
+};
 
 class Scene
 {
 public:
+    /**
+     * @brief Called for every entity with a "shape" block. Frontends use it to
+     * create their renderables; headless runs simply pass nothing.
+     */
+    using ShapeCallback = std::function<void(ECS::EntityID entity, const ShapeDescription &shape)>;
+
     std::vector<std::unique_ptr<ECS::Entity>> entities;
 
+    /**
+     * @brief Creates one world entity per scene entry, with a component per JSON block.
+     *
+     * The "id" in the file only marks an entry as an entity; the world
+     * hands out the EntityID.
+     */
     bool loadFromFile(const std::string &filename,
-                      PositionManager *positionManager,
-                      RenderableManager *renderManager,
-                      DescriptionComponentManager *descriptionManager,
-                      ControllerManager *controllerManager,
-                      MovementManager *movementManager,
-                      AIManager *aiManager,
-                      InfoBoxManager *infoBoxManager, // Add parameter
-                      Uint32 cellSize);
+                      ECS::World &world,
+                      const ShapeCallback &onShape,
+                      unsigned int cellSize);
+
+    /**
+     * @brief Defines a scene file's prefabs without creating any of its entities.
+     *
+     * For spawning into a world that came from elsewhere, e.g. a snapshot.
+     */
+    bool loadPrefabsFromFile(const std::string &filename);
+
+    /**
+     * @brief Defines or replaces a prefab from a block with the same keys as a scene entity.
+     *
+     * Scene files declare these under "prefabs"; an entity with
+     * "prefab": name starts from that block and overrides keys of its own.
+     */
+    void definePrefab(const std::string &name, const nlohmann::json &definition);
+
+    /**
+     * @brief Prefab defined under name, or null.
+     */
+    const ECS::Prefab *findPrefab(const std::string &name) const;
+
+    /**
+     * @brief Creates count entities from a prefab, laid out by placement.
+     *
+     * Components are added one type at a time so each storage grows once
+     * per batch. New entities are appended to spawned when it is given.
+     * @return bool False if no prefab has that name.
+     */
+    bool spawnBatch(ECS::World &world,
+                    const std::string &prefabName,
+                    size_t count,
+                    const SpawnPlacement &placement,
+                    const ShapeCallback &onShape,
+                    std::vector<ECS::EntityID> *spawned = nullptr);
+
+    /**
+     * @brief Where skipped entries and created controllers are reported; null keeps loading silent.
+     *
+     * Files that cannot be read at all are always reported on std::cerr.
+     */
+    void setLog(std::ostream *stream) { log = stream; }
+
+private:
+    struct PrefabDefinition
+    {
+        nlohmann::json definition; // Base that entity overrides are merged into
+        ECS::Prefab prefab;
+        bool hasShape = false;
+        ShapeDescription shape{};
+    };
+
+    std::unordered_map<std::string, PrefabDefinition> prefabs;
+    std::vector<ECS::EntityID> spawnScratch; // Reused by spawnBatch() when the caller wants no list
+    std::ostream *log = &std::cout;
 };
\ No newline at end of file
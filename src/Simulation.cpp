@@ -0,0 +1,170 @@
+#include "Simulation.h"
+#include "SimulationSnapshot.h"
+#include "./ECS/components/AIState.h"
+#include "./ECS/components/Movement.h"
+#include "./ECS/components/PositionComponent.h"
+#include "./ECS/events/AIEvents.h"
+#include <cmath>
+#include <string>
+
+Simulation::Simulation(const SimulationConfig &config)
+    : cellSize(config.cellSize),
+      movementManager(world),
+      grid(config.gridWidth, config.gridHeight),
+      pathfinder(grid),
+      clock(config.timeScale),
+      aiSystem(&world, &pathfinder, &grid, config.gemini, &clock, &homeManager, config.cellSize),
+      spatialIndex(config.cellSize * 4.0f),
+      timestep(config.stepSeconds, config.maxStepsPerFrame)
+{
+    aiSystem.seedRandom(config.seed);
+    aiSystem.setLog(config.log);
+    homeManager.setLog(config.log);
+    scene.setLog(config.log);
+    movementManager.setSpatialIndex(&spatialIndex);
+
+    // AI planning runs at a lower rate than the step; movement runs every
+    // step in step() itself, so it keeps going while paused
+    tickManager.registerSystem([this](float dt) { aiSystem.updateAI(dt); }, 0.5f, 1, "ai");
+    tickManager.registerSystem([this](float dt) { clock.update(dt); }, 0.0f, 0, "clock");
+
+    world.events().subscribe<ZoneEntered>(
+        [this](std::span<const ZoneEntered> events) { metrics.zonesEntered += events.size(); });
+    world.events().subscribe<ActivityFinished>(
+        [this](std::span<const ActivityFinished> events) { metrics.activitiesFinished += events.size(); });
+}
+
+bool Simulation::loadEnvironment(const std::string &filename) {
+    return grid.loadFromJson(filename);
+}
+
+bool Simulation::loadScene(const std::string &filename, const Scene::ShapeCallback &onShape) {
+    if (!scene.loadFromFile(filename, world, onShape, cellSize)) {
+        return false;
+    }
+    rebuildSpatialIndex();
+    return true;
+}
+
+void Simulation::prepareNpcs() {
+    for (auto [entity, aiState] : world.getAllComponents<AIState>()) {
+        homeManager.assignHome(entity, "NPC_" + std::to_string(entity));
+        aiState.currentState = AIStateName::Idle;
+        if (auto *movement = movementManager.get(entity)) {
+            MovementManager::setPhase(world, entity, *movement, MovementPhase::IDLE);
+        }
+    }
+}
+
+bool Simulation::spawnAcrossMap(const std::string &prefabName, size_t count) {
+    if (count == 0) {
+        return scene.findPrefab(prefabName) != nullptr;
+    }
+    SpawnPlacement placement;
+    placement.columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    size_t rows = (count + placement.columns - 1) / placement.columns;
+    placement.spacingX = static_cast<float>(grid.getWidth() * cellSize) / placement.columns;
+    placement.spacingY = static_cast<float>(grid.getHeight() * cellSize) / rows;
+    placement.x = placement.spacingX * 0.5f;
+    placement.y = placement.spacingY * 0.5f;
+
+    if (!scene.spawnBatch(world, prefabName, count, placement, nullptr)) {
+        return false;
+    }
+    rebuildSpatialIndex();
+    return true;
+}
+
+bool Simulation::loadSnapshot(const std::string &filename) {
+    SimulationSnapshot snapshot;
+    SimulationRunState runState;
+    if (!snapshot.loadFromFile(filename, world, homeManager, clock, runState)) {
+        return false;
+    }
+    setRunState(runState);
+    syncDerivedState();
+    return true;
+}
+
+bool Simulation::saveSnapshot(const std::string &filename) const {
+    SimulationSnapshot snapshot;
+    return snapshot.saveToFile(filename, world, homeManager, clock, getRunState());
+}
+
+SimulationRunState Simulation::getRunState() const {
+    SimulationRunState state;
+    state.randomState = aiSystem.getRandom().getState();
+    state.aiUpdateTimer = aiSystem.getUpdateTimer();
+    state.tickTime = tickManager.getTotalTime();
+    state.systemTickTimes = tickManager.getLastTickTimes();
+    state.stepAccumulator = timestep.getAccumulator();
+    return state;
+}
+
+void Simulation::setRunState(const SimulationRunState &state) {
+    aiSystem.getRandom().setState(state.randomState);
+    aiSystem.setUpdateTimer(state.aiUpdateTimer);
+    tickManager.restoreTimers(state.tickTime, state.systemTickTimes);
+    timestep.setAccumulator(state.stepAccumulator);
+}
+
+void Simulation::syncDerivedState() {
+    aiSystem.syncWithWorld();
+    rebuildSpatialIndex();
+}
+
+void Simulation::setProfiler(FrameProfiler *frameProfiler) {
+    profiler = frameProfiler;
+    tickManager.setProfiler(frameProfiler);
+    if (profiler) {
+        sectionMovement = profiler->addSection("movement");
+        sectionEvents = profiler->addSection("events");
+        sectionPlanning = profiler->addSection("ai.planning");
+    }
+}
+
+void Simulation::step(bool paused) {
+    const float deltaTime = timestep.getStepSeconds();
+    if (!paused) {
+        tickManager.update(deltaTime);
+    }
+
+    // Movement runs even while paused so the player can still walk
+    {
+        FrameProfiler::Scope scope(profiler, sectionMovement);
+        float movementScale = clock.getTimeScale() / 60.0f; // 1.0 at "normal" speed (60.0f)
+        movementManager.update(deltaTime, movementScale);
+    }
+    {
+        // Arrivals and finished planning reach the AI here
+        FrameProfiler::Scope scope(profiler, sectionEvents);
+        world.events().dispatch();
+    }
+    {
+        FrameProfiler::Scope scope(profiler, sectionPlanning);
+        aiSystem.processPlanningEntities(deltaTime);
+    }
+    ++metrics.ticks;
+}
+
+int Simulation::advance(float frameSeconds, bool paused) {
+    int steps = timestep.advance(frameSeconds);
+    for (int i = 0; i < steps; ++i) {
+        step(paused);
+    }
+    return steps;
+}
+
+void Simulation::runDays(int days) {
+    const int lastDay = clock.getDay() + days;
+    while (clock.getDay() < lastDay) {
+        step();
+    }
+}
+
+void Simulation::rebuildSpatialIndex() {
+    spatialIndex.clear();
+    for (auto [entity, pos] : world.getAllComponents<PositionComponent>()) {
+        spatialIndex.update(entity, pos.x, pos.y);
+    }
+}
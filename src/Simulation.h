@@ -0,0 +1,171 @@
+#pragma once
+#include "./ECS/World.h"
+#include "./ECS/MovementManager.h"
+#include "AISystem.h"
+#include "Clock.h"
+#include "FixedTimestep.h"
+#include "FrameProfiler.h"
+#include "Grid.h"
+#include "HomeManager.h"
+#include "Pathfinder.h"
+#include "Scene.h"
+#include "SimulationRunState.h"
+#include "SpatialHash.h"
+#include "TickManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+class GeminiClient;
+
+/**
+ * @brief Settings for one simulation instance.
+ */
+struct SimulationConfig {
+    float timeScale = 300.0f;    // Simulated seconds per real second
+    std::uint64_t seed = 1;      // Seeds every random choice the AI makes
+    unsigned int cellSize = 32;  // Grid cell size in pixels
+    float stepSeconds = 1.0f / 60.0f; // Real seconds covered by one fixed step
+    int maxStepsPerFrame = 5;    // Catch-up limit for advance()
+    int gridWidth = 20;
+    int gridHeight = 15;
+    GeminiClient *gemini = nullptr; // Optional; leave null for batch runs
+    std::ostream *log = &std::cout; // AI, home and scene messages; null keeps the run off the console
+};
+
+/**
+ * @brief Counters a simulation keeps while it runs.
+ */
+struct SimulationMetrics {
+    std::uint64_t ticks = 0;
+    size_t zonesEntered = 0;
+    size_t activitiesFinished = 0;
+};
+
+/**
+ * @brief One self-contained town: grid, pathfinder, world, clock, AI and movement.
+ *
+ * Everything a run touches lives in the instance, including the random
+ * stream, so any number of simulations can run side by side on different
+ * threads as long as each is driven by one thread at a time.
+ *
+ * Time only moves in fixed steps of SimulationConfig::stepSeconds, so a
+ * given seed produces the same town whatever the frame rate. The headless
+ * runner calls step() directly; the windowed build feeds its real frame
+ * times to advance(), which runs as many steps as have come due. Both
+ * share one update order. Instances hold pointers to their own members
+ * and are neither copyable nor movable.
+ */
+class Simulation {
+public:
+    explicit Simulation(const SimulationConfig &config);
+
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+
+    bool loadEnvironment(const std::string &filename);
+
+    /**
+     * @brief Creates the scene's entities; frontends pass onShape to create their renderables.
+     */
+    bool loadScene(const std::string &filename, const Scene::ShapeCallback &onShape = nullptr);
+
+    /**
+     * @brief Defines a scene file's prefabs only, so spawnAcrossMap() works after loadSnapshot().
+     */
+    bool loadPrefabs(const std::string &filename) { return scene.loadPrefabsFromFile(filename); }
+
+    /**
+     * @brief Gives every NPC a home and puts it in the idle state, ready for its first plan.
+     *
+     * For fresh scenes only; snapshots already carry homes and AI state.
+     */
+    void prepareNpcs();
+
+    /**
+     * @brief Spawns count entities from a scene prefab on an even grid over the whole map.
+     * @return bool False if the scene has no such prefab.
+     */
+    bool spawnAcrossMap(const std::string &prefabName, size_t count);
+
+    bool loadSnapshot(const std::string &filename);
+    bool saveSnapshot(const std::string &filename) const;
+
+    /**
+     * @brief Rebuilds the spatial index and AI caches after the world was replaced wholesale.
+     */
+    void syncDerivedState();
+
+    /**
+     * @brief Random stream and timers that snapshots and checkpoints save alongside the world.
+     */
+    SimulationRunState getRunState() const;
+    void setRunState(const SimulationRunState &state);
+
+    /**
+     * @brief Adds this simulation's sections to profiler; call before stepping.
+     */
+    void setProfiler(FrameProfiler *profiler);
+
+    /**
+     * @brief Advances the town by one fixed step.
+     *
+     * While paused the clock and AI stand still but movement keeps running
+     * so the player can still walk.
+     */
+    void step(bool paused = false);
+
+    /**
+     * @brief Banks frameSeconds of real time and runs every step that has come due.
+     *
+     * Runs at most SimulationConfig::maxStepsPerFrame steps; see FixedTimestep.
+     * @return int Number of steps run.
+     */
+    int advance(float frameSeconds, bool paused = false);
+
+    /**
+     * @brief Steps until days simulated days have passed.
+     */
+    void runDays(int days);
+
+    ECS::World &getWorld() { return world; }
+    const ECS::World &getWorld() const { return world; }
+    Grid &getGrid() { return grid; }
+    const Grid &getGrid() const { return grid; }
+    Clock &getClock() { return clock; }
+    const Clock &getClock() const { return clock; }
+    HomeManager &getHomeManager() { return homeManager; }
+    const HomeManager &getHomeManager() const { return homeManager; }
+    AISystem &getAISystem() { return aiSystem; }
+    MovementManager &getMovementManager() { return movementManager; }
+    SpatialHash &getSpatialIndex() { return spatialIndex; }
+    const SpatialHash &getSpatialIndex() const { return spatialIndex; }
+    Scene &getScene() { return scene; }
+    unsigned int getCellSize() const { return cellSize; }
+    const SimulationMetrics &getMetrics() const { return metrics; }
+    const FixedTimestep &getTimestep() const { return timestep; }
+    float getStepSeconds() const { return timestep.getStepSeconds(); }
+
+private:
+    unsigned int cellSize;
+    ECS::World world;
+    HomeManager homeManager;
+    MovementManager movementManager;
+    Grid grid;
+    Pathfinder pathfinder;
+    Scene scene;
+    Clock clock;
+    TickManager tickManager;
+    AISystem aiSystem;
+    SpatialHash spatialIndex;
+    FixedTimestep timestep;
+    SimulationMetrics metrics;
+
+    FrameProfiler *profiler = nullptr;
+    FrameProfiler::SectionId sectionMovement = -1;
+    FrameProfiler::SectionId sectionEvents = -1;
+    FrameProfiler::SectionId sectionPlanning = -1;
+
+    void rebuildSpatialIndex();
+};
@@ -0,0 +1,28 @@
+#include "SimulationCheckpoints.h"
+
+SimulationCheckpoints::SimulationCheckpoints(size_t capacity) : ring(capacity) {}
+
+void SimulationCheckpoints::capture(const ECS::World &world, const Grid &grid, const HomeManager &homeManager,
+                                    const Clock &clock, const SimulationRunState &runState) {
+    Checkpoint &checkpoint = ring.push();
+    world.saveCheckpoint(checkpoint.world);
+    checkpoint.grid.copyStateFrom(grid);
+    checkpoint.homes = homeManager;
+    checkpoint.clock = clock.getState();
+    checkpoint.run = runState;
+}
+
+bool SimulationCheckpoints::rewind(size_t stepsBack, ECS::World &world, Grid &grid, HomeManager &homeManager,
+                                   Clock &clock, SimulationRunState &runState) {
+    const Checkpoint *checkpoint = ring.get(stepsBack);
+    if (!checkpoint) {
+        return false;
+    }
+    world.restoreCheckpoint(checkpoint->world);
+    grid.copyStateFrom(checkpoint->grid);
+    homeManager = checkpoint->homes;
+    clock.setState(checkpoint->clock);
+    runState = checkpoint->run;
+    ring.discardNewest(stepsBack);
+    return true;
+}
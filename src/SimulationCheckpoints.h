@@ -0,0 +1,53 @@
+#pragma once
+#include "./ECS/World.h"
+#include "./ECS/CheckpointRing.h"
+#include "Grid.h"
+#include "HomeManager.h"
+#include "Clock.h"
+#include "SimulationRunState.h"
+#include <cstddef>
+
+/**
+ * @brief Bounded ring of in-memory checkpoints of the running simulation.
+ *
+ * Each checkpoint copies the ECS world, the grid, the home assignments, the
+ * clock and the run state (random stream and timers) into buffers the ring
+ * keeps between captures, so capturing and rewinding cost time proportional
+ * to the state size and stop allocating once every slot has been used.
+ * Unlike SimulationSnapshot nothing is encoded; this is meant for frequent
+ * rollback and what-if runs within one process. Systems that cache
+ * per-entity state (AISystem) must be resynchronized after a rewind.
+ */
+class SimulationCheckpoints {
+public:
+    explicit SimulationCheckpoints(size_t capacity);
+
+    void capture(const ECS::World &world, const Grid &grid, const HomeManager &homeManager,
+                 const Clock &clock, const SimulationRunState &runState);
+
+    /**
+     * @brief Restores the checkpoint taken stepsBack captures before the newest.
+     *
+     * Newer checkpoints are discarded so the next capture follows the
+     * restored one; the restored checkpoint itself is kept, so the same
+     * point can be rewound to repeatedly.
+     * @return bool False if there is no such checkpoint.
+     */
+    bool rewind(size_t stepsBack, ECS::World &world, Grid &grid, HomeManager &homeManager,
+                Clock &clock, SimulationRunState &runState);
+
+    size_t size() const { return ring.size(); }
+    size_t capacity() const { return ring.capacity(); }
+    void clear() { ring.clear(); }
+
+private:
+    struct Checkpoint {
+        ECS::WorldCheckpoint world;
+        Grid grid{0, 0};
+        HomeManager homes;
+        Clock::State clock{};
+        SimulationRunState run;
+    };
+
+    ECS::CheckpointRing<Checkpoint> ring;
+};
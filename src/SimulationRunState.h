@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Simulation state kept outside the world and the managers.
+ *
+ * The AI's random stream and the timers that decide when it plans shape
+ * every later step, so a loaded or rewound run only repeats the original
+ * if they come back with the world. Snapshots and checkpoints carry one.
+ */
+struct SimulationRunState {
+    std::uint64_t randomState = 1;
+    float aiUpdateTimer = 0.0f;
+    float tickTime = 0.0f;              // TickManager total time
+    std::vector<float> systemTickTimes; // Last tick time of each TickManager system
+    double stepAccumulator = 0.0;       // Real time banked towards the next fixed step
+};
@@ -0,0 +1,247 @@
+#include "SimulationSnapshot.h"
+#include "HomeManager.h"
+#include "Clock.h"
+#include "./ECS/components/PositionComponent.h"
+#include "./ECS/components/Movement.h"
+#include "./ECS/components/AIState.h"
+#include "./ECS/components/Controller.h"
+#include "./ECS/components/DescriptionComponent.h"
+#include "./ECS/components/InfoBoxComponent.h"
+#include "./ECS/components/RoleTags.h"
+
+#include <algorithm>
+
+namespace ECS {
+    template<>
+    struct SnapshotTraits<PositionComponent> {
+        static constexpr const char *name = "Position";
+
+        static void write(SnapshotWriter &writer, const PositionComponent &position) {
+            writer.write(position.x);
+            writer.write(position.y);
+        }
+
+        static PositionComponent read(SnapshotReader &reader) {
+            float x = reader.read<float>();
+            float y = reader.read<float>();
+            return PositionComponent(x, y);
+        }
+    };
+
+    template<>
+    struct SnapshotTraits<Movement> {
+        static constexpr const char *name = "Movement";
+
+        static void write(SnapshotWriter &writer, const Movement &movement) {
+            writer.write(movement.targetX);
+            writer.write(movement.targetY);
+            writer.write(movement.speed);
+            writer.write(movement.isMoving);
+            writer.write(movement.phase);
+            writer.write(movement.phaseTimer);
+            writer.write(movement.planningDuration);
+            writer.write(movement.arrivingDuration);
+        }
+
+        static Movement read(SnapshotReader &reader) {
+            Movement movement(0.0f);
+            reader.read(movement.targetX);
+            reader.read(movement.targetY);
+            reader.read(movement.speed);
+            reader.read(movement.isMoving);
+            reader.read(movement.phase);
+            reader.read(movement.phaseTimer);
+            reader.read(movement.planningDuration);
+            reader.read(movement.arrivingDuration);
+            return movement;
+        }
+    };
+
+    template<>
+    struct SnapshotTraits<AIState> {
+        static constexpr const char *name = "AIState";
+
+        static void write(SnapshotWriter &writer, const AIState &state) {
+            writer.write(state.currentState);
+            writer.writeString(state.targetZone);
+            writer.writeString(state.intendedActivity);
+            writer.write(state.timeInCurrentState);
+            writer.write(state.activityTimer);
+        }
+
+        static AIState read(SnapshotReader &reader) {
+            AIState state;
+            reader.read(state.currentState);
+            reader.readString(state.targetZone);
+            reader.readString(state.intendedActivity);
+            reader.read(state.timeInCurrentState);
+            reader.read(state.activityTimer);
+            return state;
+        }
+    };
+
+    template<>
+    struct SnapshotTraits<Controller> {
+        static constexpr const char *name = "Controller";
+
+        static void write(SnapshotWriter &writer, const Controller &controller) {
+            writer.writeString(controller.type);
+        }
+
+        static Controller read(SnapshotReader &reader) {
+            Controller controller;
+            reader.readString(controller.type);
+            return controller;
+        }
+    };
+
+    template<>
+    struct SnapshotTraits<DescriptionComponent> {
+        static constexpr const char *name = "Description";
+
+        static void write(SnapshotWriter &writer, const DescriptionComponent &description) {
+            writer.writeString(description.name);
+            writer.writeString(description.text);
+        }
+
+        static DescriptionComponent read(SnapshotReader &reader) {
+            DescriptionComponent description("", "");
+            reader.readString(description.name);
+            reader.readString(description.text);
+            return description;
+        }
+    };
+
+    template<>
+    struct SnapshotTraits<InfoBoxComponent> {
+        static constexpr const char *name = "InfoBox";
+
+        static void write(SnapshotWriter &writer, const InfoBoxComponent &infoBox) {
+            writer.writeString(infoBox.text);
+        }
+
+        static InfoBoxComponent read(SnapshotReader &reader) {
+            InfoBoxComponent infoBox;
+            reader.readString(infoBox.text);
+            return infoBox;
+        }
+    };
+}
+
+SimulationSnapshot::SimulationSnapshot()
+{
+    serializer.registerComponent<PositionComponent>();
+    serializer.registerComponent<Movement>();
+    serializer.registerComponent<AIState>();
+    serializer.registerComponent<Controller>();
+    serializer.registerComponent<DescriptionComponent>();
+    serializer.registerComponent<InfoBoxComponent>();
+    serializer.registerTag<PlayerTag>("Player");
+    serializer.registerTag<GuardianTag>("Guardian");
+    serializer.registerTag<CitizenTag>("Citizen");
+}
+
+void SimulationSnapshot::write(ECS::SnapshotWriter &writer, const ECS::World &world, const HomeManager &homeManager,
+                               const Clock &clock, const SimulationRunState &runState) const
+{
+    writer.write(MAGIC);
+    writer.write(VERSION);
+    serializer.save(world, writer);
+
+    // Sorted so the same state always writes the same bytes, whatever the map order
+    auto assignments = homeManager.getAllAssignments();
+    std::sort(assignments.begin(), assignments.end(),
+              [](const HomeAssignment &a, const HomeAssignment &b) { return a.npcId < b.npcId; });
+    writer.write(static_cast<std::uint32_t>(assignments.size()));
+    for (const auto &assignment : assignments)
+    {
+        writer.write(static_cast<std::int32_t>(assignment.npcId));
+        writer.writeString(assignment.zoneName);
+    }
+
+    Clock::State clockState = clock.getState();
+    writer.write(clockState.totalSeconds);
+    writer.write(clockState.hour);
+    writer.write(clockState.minute);
+    writer.write(clockState.day);
+    writer.write(clockState.timeScale);
+    writer.write(clockState.paused);
+
+    writer.write(runState.randomState);
+    writer.write(runState.aiUpdateTimer);
+    writer.write(runState.tickTime);
+    writer.write(static_cast<std::uint32_t>(runState.systemTickTimes.size()));
+    for (float time : runState.systemTickTimes)
+    {
+        writer.write(time);
+    }
+    writer.write(runState.stepAccumulator);
+}
+
+bool SimulationSnapshot::read(ECS::SnapshotReader &reader, ECS::World &world, HomeManager &homeManager,
+                              Clock &clock, SimulationRunState &runState) const
+{
+    if (reader.read<std::uint32_t>() != MAGIC || reader.read<std::uint32_t>() != VERSION)
+    {
+        return false;
+    }
+    // Nothing is replaced until the whole snapshot has been read and checked
+    ECS::WorldSerializer::StagedWorld stagedWorld;
+    if (!serializer.decode(reader, stagedWorld))
+    {
+        return false;
+    }
+
+    std::uint32_t assignmentCount = reader.read<std::uint32_t>();
+    std::vector<HomeAssignment> assignments;
+    for (std::uint32_t i = 0; i < assignmentCount && reader.ok(); ++i)
+    {
+        HomeAssignment assignment;
+        assignment.npcId = reader.read<std::int32_t>();
+        reader.readString(assignment.zoneName);
+        assignments.push_back(std::move(assignment));
+    }
+
+    Clock::State clockState{};
+    reader.read(clockState.totalSeconds);
+    reader.read(clockState.hour);
+    reader.read(clockState.minute);
+    reader.read(clockState.day);
+    reader.read(clockState.timeScale);
+    reader.read(clockState.paused);
+
+    SimulationRunState state;
+    reader.read(state.randomState);
+    reader.read(state.aiUpdateTimer);
+    reader.read(state.tickTime);
+    std::uint32_t systemCount = reader.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < systemCount && reader.ok(); ++i)
+    {
+        state.systemTickTimes.push_back(reader.read<float>());
+    }
+    reader.read(state.stepAccumulator);
+    if (!reader.ok() || !serializer.commit(world, stagedWorld))
+    {
+        return false;
+    }
+
+    homeManager.restoreAssignments(assignments);
+    clock.setState(clockState);
+    runState = std::move(state);
+    return true;
+}
+
+bool SimulationSnapshot::saveToFile(const std::string &filename, const ECS::World &world, const HomeManager &homeManager,
+                                    const Clock &clock, const SimulationRunState &runState) const
+{
+    ECS::SnapshotWriter writer;
+    write(writer, world, homeManager, clock, runState);
+    return writer.saveToFile(filename);
+}
+
+bool SimulationSnapshot::loadFromFile(const std::string &filename, ECS::World &world, HomeManager &homeManager,
+                                      Clock &clock, SimulationRunState &runState) const
+{
+    ECS::SnapshotReader reader;
+    return reader.loadFromFile(filename) && read(reader, world, homeManager, clock, runState);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "./ECS/Snapshot.h"
+#include "SimulationRunState.h"
+#include <cstdint>
+#include <string>
+
+class HomeManager;
+class Clock;
+
+/**
+ * @brief Binary save files for a running simulation.
+ *
+ * A snapshot holds a header (magic and format version), the ECS world with
+ * every simulation component, the home assignments, the clock and the
+ * run state (random stream and timers). Loading
+ * one into freshly constructed managers resumes the simulation exactly
+ * where it was saved. Systems that cache per-entity state (AISystem) must
+ * be resynchronized after a load. A load that fails changes nothing.
+ */
+class SimulationSnapshot {
+public:
+    static constexpr std::uint32_t MAGIC = 0x4E535242; // "BRSN"
+    static constexpr std::uint32_t VERSION = 2;
+
+    SimulationSnapshot();
+
+    void write(ECS::SnapshotWriter &writer, const ECS::World &world, const HomeManager &homeManager,
+               const Clock &clock, const SimulationRunState &runState) const;
+    bool read(ECS::SnapshotReader &reader, ECS::World &world, HomeManager &homeManager,
+              Clock &clock, SimulationRunState &runState) const;
+
+    bool saveToFile(const std::string &filename, const ECS::World &world, const HomeManager &homeManager,
+                    const Clock &clock, const SimulationRunState &runState) const;
+    bool loadFromFile(const std::string &filename, ECS::World &world, HomeManager &homeManager,
+                      Clock &clock, SimulationRunState &runState) const;
+
+private:
+    ECS::WorldSerializer serializer;
+};
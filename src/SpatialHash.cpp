@@ -0,0 +1,174 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+SpatialHash::SpatialHash(float bucketSize) : bucketSize(bucketSize) {}
+
+int SpatialHash::toBucket(float coord) const {
+    return static_cast<int>(std::floor(coord / bucketSize));
+}
+
+void SpatialHash::update(unsigned int uid, float x, float y) {
+    BucketKey key = makeKey(toBucket(x), toBucket(y));
+
+    auto it = entityBucket.find(uid);
+    if (it != entityBucket.end()) {
+        Location& location = it->second;
+        if (location.key == key) {
+            // Still in the same bucket; just refresh the stored position
+            Entry& entry = buckets[key][location.slot];
+            entry.x = x;
+            entry.y = y;
+            return;
+        }
+        eraseFromBucket(location);
+    } else {
+        it = entityBucket.emplace(uid, Location{}).first;
+    }
+
+    auto& bucket = buckets[key];
+    it->second = {key, static_cast<std::uint32_t>(bucket.size())};
+    bucket.push_back({uid, x, y});
+}
+
+void SpatialHash::remove(unsigned int uid) {
+    auto it = entityBucket.find(uid);
+    if (it == entityBucket.end()) return;
+
+    eraseFromBucket(it->second);
+    entityBucket.erase(it);
+}
+
+void SpatialHash::clear() {
+    buckets.clear();
+    entityBucket.clear();
+}
+
+void SpatialHash::eraseFromBucket(const Location& location) {
+    auto bucketIt = buckets.find(location.key);
+    if (bucketIt == buckets.end()) return;
+
+    // Order inside a bucket does not matter, so swap-and-pop and tell the
+    // moved entry where it now lives
+    auto& bucket = bucketIt->second;
+    if (location.slot + 1 != bucket.size()) {
+        bucket[location.slot] = bucket.back();
+        entityBucket[bucket[location.slot].uid].slot = location.slot;
+    }
+    bucket.pop_back();
+    if (bucket.empty()) {
+        buckets.erase(bucketIt);
+    }
+}
+
+void SpatialHash::queryRect(float x, float y, float width, float height,
+                            std::vector<unsigned int>& out) const {
+    forEachInBuckets(toBucket(x), toBucket(y), toBucket(x + width), toBucket(y + height),
+                     [&out](const Entry& entry) { out.push_back(entry.uid); });
+}
+
+void SpatialHash::queryRectExact(float x, float y, float width, float height,
+                                 std::vector<unsigned int>& out) const {
+    forEachInBuckets(toBucket(x), toBucket(y), toBucket(x + width), toBucket(y + height),
+                     [&](const Entry& entry) {
+                         if (entry.x >= x && entry.x <= x + width && entry.y >= y && entry.y <= y + height) {
+                             out.push_back(entry.uid);
+                         }
+                     });
+}
+
+void SpatialHash::queryRadius(float x, float y, float radius, std::vector<unsigned int>& out) const {
+    const float radiusSquared = radius * radius;
+    forEachInBuckets(toBucket(x - radius), toBucket(y - radius), toBucket(x + radius), toBucket(y + radius),
+                     [&](const Entry& entry) {
+                         float dx = entry.x - x;
+                         float dy = entry.y - y;
+                         if (dx * dx + dy * dy <= radiusSquared) {
+                             out.push_back(entry.uid);
+                         }
+                     });
+}
+
+void SpatialHash::queryNearest(float x, float y, size_t k, std::vector<unsigned int>& out,
+                               float maxRadius) const {
+    if (k == 0 || buckets.empty()) return;
+
+    const float maxDistanceSquared = maxRadius * maxRadius;
+    const int centerX = toBucket(x);
+    const int centerY = toBucket(y);
+    std::vector<std::pair<float, unsigned int>> found; // (squared distance, uid)
+    size_t seen = 0;
+
+    auto consider = [&](const Entry& entry) {
+        ++seen;
+        float dx = entry.x - x;
+        float dy = entry.y - y;
+        float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared <= maxDistanceSquared) {
+            found.emplace_back(distanceSquared, entry.uid);
+        }
+    };
+
+    for (int ring = 0; ; ++ring) {
+        if (ring > 0 && static_cast<size_t>(8 * ring) > buckets.size()) {
+            // A ring now has more cells than there are buckets, so visit the
+            // remaining buckets directly instead of probing empty cells
+            for (const auto& [key, bucket] : buckets) {
+                int bx = static_cast<int>(key >> 32);
+                int by = static_cast<int>(static_cast<std::int32_t>(key & 0xffffffff));
+                if (std::max(std::abs(bx - centerX), std::abs(by - centerY)) >= ring) {
+                    for (const Entry& entry : bucket) {
+                        consider(entry);
+                    }
+                }
+            }
+            break;
+        }
+
+        if (ring == 0) {
+            forEachInBuckets(centerX, centerY, centerX, centerY, consider);
+        } else {
+            // Top and bottom rows, then the left and right columns between them
+            forEachInBuckets(centerX - ring, centerY - ring, centerX + ring, centerY - ring, consider);
+            forEachInBuckets(centerX - ring, centerY + ring, centerX + ring, centerY + ring, consider);
+            forEachInBuckets(centerX - ring, centerY - ring + 1, centerX - ring, centerY + ring - 1, consider);
+            forEachInBuckets(centerX + ring, centerY - ring + 1, centerX + ring, centerY + ring - 1, consider);
+        }
+        if (seen == entityBucket.size()) break;
+
+        // Everything closer than reach has been visited
+        float reach = std::min({x - (centerX - ring) * bucketSize, (centerX + ring + 1) * bucketSize - x,
+                                y - (centerY - ring) * bucketSize, (centerY + ring + 1) * bucketSize - y});
+        if (reach > maxRadius) break;
+        if (found.size() >= k) {
+            std::nth_element(found.begin(), found.begin() + (k - 1), found.end());
+            if (found[k - 1].first < reach * reach) break;
+        }
+    }
+
+    size_t count = std::min(k, found.size());
+    std::partial_sort(found.begin(), found.begin() + count, found.end());
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(found[i].second);
+    }
+}
+
+bool SpatialHash::findNearest(float x, float y, float maxRadius, unsigned int& uid) const {
+    std::vector<unsigned int> nearest;
+    queryNearest(x, y, 1, nearest, maxRadius);
+    if (nearest.empty()) return false;
+    uid = nearest.front();
+    return true;
+}
+
+bool SpatialHash::getPosition(unsigned int uid, float& x, float& y) const {
+    auto it = entityBucket.find(uid);
+    if (it == entityBucket.end()) return false;
+
+    const Entry& entry = buckets.at(it->second.key)[it->second.slot];
+    x = entry.x;
+    y = entry.y;
+    return true;
+}
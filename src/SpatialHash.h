@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Uniform bucket grid over entity positions.
+ *
+ * Entities are filed into square buckets by their pixel position, and each
+ * bucket keeps the positions it was given, so queries can test entities
+ * exactly without touching the world. Moving an entity within its bucket
+ * only overwrites its stored position; crossing into another bucket moves
+ * it in O(1). Queries visit only the buckets that can hold a match, so
+ * their cost follows the size of the query area and of the result rather
+ * than the number of indexed entities.
+ *
+ * MovementManager keeps the index current as entities move; anything that
+ * teleports entities, such as snapshot loads and checkpoint rewinds, must
+ * update() or rebuild it. Its readers are the renderer's culling
+ * (queryRect) and input picking (findNearest); the exact queries are
+ * there for gameplay code that needs who is near a point or inside a zone.
+ */
+class SpatialHash {
+public:
+    /**
+     * @param bucketSize Side length of one bucket in world pixels.
+     */
+    explicit SpatialHash(float bucketSize = 128.0f);
+
+    /**
+     * @brief Inserts an entity, or moves it if it is already indexed.
+     */
+    void update(unsigned int uid, float x, float y);
+
+    void remove(unsigned int uid);
+    void clear();
+
+    /**
+     * @brief Appends every entity in buckets overlapping the rectangle to out.
+     *
+     * Results are bucket-granular, which is what viewport culling wants:
+     * callers needing exact containment use queryRectExact().
+     */
+    void queryRect(float x, float y, float width, float height,
+                   std::vector<unsigned int>& out) const;
+
+    /**
+     * @brief Appends every entity whose position lies inside the rectangle to out.
+     */
+    void queryRectExact(float x, float y, float width, float height,
+                        std::vector<unsigned int>& out) const;
+
+    /**
+     * @brief Appends every entity within radius of (x, y) to out, in no particular order.
+     */
+    void queryRadius(float x, float y, float radius, std::vector<unsigned int>& out) const;
+
+    /**
+     * @brief Appends up to k entities nearest to (x, y) to out, nearest first.
+     *
+     * Buckets are searched in growing square rings and the search stops as
+     * soon as no unsearched bucket can hold anything closer than the k-th
+     * candidate, or once maxRadius is exceeded. Ties are broken by uid so
+     * the result is deterministic.
+     */
+    void queryNearest(float x, float y, size_t k, std::vector<unsigned int>& out,
+                      float maxRadius = std::numeric_limits<float>::infinity()) const;
+
+    /**
+     * @brief Finds the entity nearest to (x, y) within maxRadius, e.g. for mouse picking.
+     * @return bool False if there is none.
+     */
+    bool findNearest(float x, float y, float maxRadius, unsigned int& uid) const;
+
+    /**
+     * @brief Position an entity was last indexed at.
+     * @return bool False if the entity is not indexed.
+     */
+    bool getPosition(unsigned int uid, float& x, float& y) const;
+
+    size_t size() const { return entityBucket.size(); }
+    float getBucketSize() const { return bucketSize; }
+
+private:
+    using BucketKey = std::int64_t;
+
+    struct Entry {
+        unsigned int uid;
+        float x, y;
+    };
+
+    /**
+     * @brief Where an entity's entry lives: its bucket and its index in that bucket.
+     */
+    struct Location {
+        BucketKey key;
+        std::uint32_t slot;
+    };
+
+    float bucketSize;
+    std::unordered_map<BucketKey, std::vector<Entry>> buckets;
+    std::unordered_map<unsigned int, Location> entityBucket;
+
+    int toBucket(float coord) const;
+    static BucketKey makeKey(int bx, int by) {
+        return (static_cast<BucketKey>(bx) << 32) | static_cast<std::uint32_t>(by);
+    }
+    void eraseFromBucket(const Location& location);
+
+    /**
+     * @brief Calls func(entry) for every entry in the buckets from (minBX, minBY) to (maxBX, maxBY).
+     */
+    template<typename Func>
+    void forEachInBuckets(int minBX, int minBY, int maxBX, int maxBY, Func&& func) const {
+        for (int by = minBY; by <= maxBY; ++by) {
+            for (int bx = minBX; bx <= maxBX; ++bx) {
+                auto it = buckets.find(makeKey(bx, by));
+                if (it == buckets.end()) continue;
+                for (const Entry& entry : it->second) {
+                    func(entry);
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,161 @@
+#include "TextRenderer.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    constexpr int ATLAS_WIDTH = 512;
+    constexpr int GLYPH_PADDING = 1;  // Gap between glyphs to avoid sampling bleed
+}
+
+TextRenderer::TextRenderer(SDL_Renderer* renderer, TTF_Font* font)
+    : renderer(renderer)
+{
+    if (!renderer || !font) return;
+
+    const SDL_Color white = {255, 255, 255, 255};
+    const int glyphCount = LAST_GLYPH - FIRST_GLYPH + 1;
+
+    // Rasterise every glyph once, remembering where it will go in the atlas
+    std::vector<SDL_Surface*> surfaces(glyphCount, nullptr);
+    std::vector<SDL_Rect> placements(glyphCount, SDL_Rect{0, 0, 0, 0});
+
+    // Reserve a small white block in the top-left corner for solid quads
+    int penX = 2 + GLYPH_PADDING;
+    int penY = 0;
+    int rowHeight = 2;
+
+    for (int i = 0; i < glyphCount; ++i) {
+        char ch = static_cast<char>(FIRST_GLYPH + i);
+        SDL_Surface* surface = TTF_RenderText_Blended(font, &ch, 1, white);
+        if (!surface) continue;
+
+        if (penX + surface->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + GLYPH_PADDING;
+            rowHeight = 0;
+        }
+
+        surfaces[i] = surface;
+        placements[i] = {penX, penY, surface->w, surface->h};
+        penX += surface->w + GLYPH_PADDING;
+        rowHeight = std::max(rowHeight, surface->h);
+        lineHeight = std::max(lineHeight, static_cast<float>(surface->h));
+    }
+
+    int atlasHeight = penY + rowHeight;
+    SDL_Surface* atlasSurface = SDL_CreateSurface(ATLAS_WIDTH, atlasHeight, SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurface) {
+        SDL_FillSurfaceRect(atlasSurface, nullptr, SDL_MapSurfaceRGBA(atlasSurface, 0, 0, 0, 0));
+
+        SDL_Rect whiteRect = {0, 0, 2, 2};
+        SDL_FillSurfaceRect(atlasSurface, &whiteRect, SDL_MapSurfaceRGBA(atlasSurface, 255, 255, 255, 255));
+        whiteTexel = {1.0f / ATLAS_WIDTH, 1.0f / atlasHeight};
+
+        for (int i = 0; i < glyphCount; ++i) {
+            if (!surfaces[i]) continue;
+
+            // Copy alpha straight through rather than blending onto the clear atlas
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surfaces[i], nullptr, atlasSurface, &placements[i]);
+
+            const SDL_Rect& p = placements[i];
+            glyphs[i].uv = {
+                static_cast<float>(p.x) / ATLAS_WIDTH,
+                static_cast<float>(p.y) / atlasHeight,
+                static_cast<float>(p.w) / ATLAS_WIDTH,
+                static_cast<float>(p.h) / atlasHeight};
+            glyphs[i].width = static_cast<float>(p.w);
+        }
+
+        atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+        if (atlas) {
+            SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+        } else {
+            std::cerr << "TextRenderer: failed to create atlas texture: " << SDL_GetError() << std::endl;
+        }
+        SDL_DestroySurface(atlasSurface);
+    }
+
+    for (SDL_Surface* surface : surfaces) {
+        if (surface) SDL_DestroySurface(surface);
+    }
+}
+
+TextRenderer::~TextRenderer() {
+    if (atlas) SDL_DestroyTexture(atlas);
+}
+
+const TextRenderer::Glyph* TextRenderer::findGlyph(char c) const {
+    int index = static_cast<unsigned char>(c) - FIRST_GLYPH;
+    if (index < 0 || index > LAST_GLYPH - FIRST_GLYPH) {
+        index = '?' - FIRST_GLYPH;
+    }
+    return &glyphs[index];
+}
+
+SDL_FPoint TextRenderer::measure(const std::string& text) const {
+    float maxWidth = 0;
+    float lineWidth = 0;
+    int lines = 1;
+
+    for (char c : text) {
+        if (c == '\n') {
+            maxWidth = std::max(maxWidth, lineWidth);
+            lineWidth = 0;
+            ++lines;
+            continue;
+        }
+        lineWidth += findGlyph(c)->width;
+    }
+    maxWidth = std::max(maxWidth, lineWidth);
+
+    return {maxWidth, lines * lineHeight};
+}
+
+void TextRenderer::addText(const std::string& text, float x, float y, SDL_Color color) {
+    if (!atlas) return;
+
+    float penX = x;
+    float penY = y;
+
+    for (char c : text) {
+        if (c == '\n') {
+            penX = x;
+            penY += lineHeight;
+            continue;
+        }
+
+        const Glyph* glyph = findGlyph(c);
+        if (c != ' ') {
+            addQuad({penX, penY, glyph->width, lineHeight}, glyph->uv, color);
+        }
+        penX += glyph->width;
+    }
+}
+
+void TextRenderer::addRect(const SDL_FRect& rect, SDL_Color color) {
+    if (!atlas) return;
+    addQuad(rect, {whiteTexel.x, whiteTexel.y, 0, 0}, color);
+}
+
+void TextRenderer::addQuad(const SDL_FRect& dst, const SDL_FRect& uv, SDL_Color color) {
+    SDL_FColor fc = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+    int base = static_cast<int>(vertices.size());
+
+    vertices.push_back({{dst.x, dst.y}, fc, {uv.x, uv.y}});
+    vertices.push_back({{dst.x + dst.w, dst.y}, fc, {uv.x + uv.w, uv.y}});
+    vertices.push_back({{dst.x + dst.w, dst.y + dst.h}, fc, {uv.x + uv.w, uv.y + uv.h}});
+    vertices.push_back({{dst.x, dst.y + dst.h}, fc, {uv.x, uv.y + uv.h}});
+
+    indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+
+void TextRenderer::flush() {
+    if (atlas && !indices.empty()) {
+        SDL_RenderGeometry(renderer, atlas,
+                           vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+    vertices.clear();
+    indices.clear();
+}
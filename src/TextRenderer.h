@@ -0,0 +1,85 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Batched text renderer backed by a glyph atlas.
+ *
+ * The printable ASCII range of the font is rasterised once into a single
+ * texture when the renderer is created. Strings are then laid out into
+ * textured quads and submitted together with SDL_RenderGeometry, so the
+ * per-frame cost of UI text is vertex generation only.
+ *
+ * The atlas also contains a single white texel, which lets background
+ * boxes be drawn in the same batch as the text that sits on top of them.
+ */
+class TextRenderer {
+public:
+    /**
+     * @brief Builds the glyph atlas for the given font.
+     * @param renderer The renderer the atlas texture is created on.
+     * @param font The font to rasterise. Only used during construction.
+     */
+    TextRenderer(SDL_Renderer* renderer, TTF_Font* font);
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    /**
+     * @brief Returns true if the atlas texture was created successfully.
+     */
+    bool isValid() const { return atlas != nullptr; }
+
+    /**
+     * @brief Height of one line of text in pixels.
+     */
+    float getLineHeight() const { return lineHeight; }
+
+    /**
+     * @brief Measures a (possibly multi-line) string without drawing it.
+     * @return Width of the widest line and total height of all lines.
+     */
+    SDL_FPoint measure(const std::string& text) const;
+
+    /**
+     * @brief Queues a string for drawing. '\n' starts a new line.
+     * @param x Left edge of the first line.
+     * @param y Top edge of the first line.
+     */
+    void addText(const std::string& text, float x, float y, SDL_Color color);
+
+    /**
+     * @brief Queues a solid filled rectangle in the same batch as the text.
+     */
+    void addRect(const SDL_FRect& rect, SDL_Color color);
+
+    /**
+     * @brief Submits all queued quads in one draw call and clears the batch.
+     */
+    void flush();
+
+private:
+    struct Glyph {
+        SDL_FRect uv;      // Normalised texture coordinates within the atlas
+        float width = 0;   // Pixel width of the glyph cell (also its advance)
+    };
+
+    static constexpr int FIRST_GLYPH = 32;  // ' '
+    static constexpr int LAST_GLYPH = 126;  // '~'
+
+    SDL_Renderer* renderer;
+    SDL_Texture* atlas = nullptr;
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+    SDL_FPoint whiteTexel = {0, 0};
+    float lineHeight = 0;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    const Glyph* findGlyph(char c) const;
+    void addQuad(const SDL_FRect& dst, const SDL_FRect& uv, SDL_Color color);
+};
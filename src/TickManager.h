@@ -1,7 +1,9 @@
 #pragma once
 #include <functional>
+#include <string>
 #include <vector>
 #include <algorithm>
+#include "FrameProfiler.h"
 
 /**
  * @brief Coordinates timed updates across multiple systems.
@@ -18,14 +20,24 @@ public:
         float tickInterval;
         float lastTickTime;
         int priority;  // Lower numbers execute first
+        std::string name;
+        FrameProfiler::SectionId profileSection = -1;
         
-        SystemRegistration(TickCallback cb, float interval, int prio = 0)
-            : callback(cb), tickInterval(interval), lastTickTime(0.0f), priority(prio) {}
+        SystemRegistration(TickCallback cb, float interval, int prio = 0, std::string systemName = "")
+            : callback(cb), tickInterval(interval), lastTickTime(0.0f), priority(prio), name(std::move(systemName)) {}
     };
 
 private:
     std::vector<SystemRegistration> systems;
     float totalTime = 0.0f;
+    FrameProfiler* profiler = nullptr;
+
+    void assignProfileSection(SystemRegistration& system) {
+        if (profiler) {
+            std::string label = system.name.empty() ? "tick." + std::to_string(system.priority) : "tick." + system.name;
+            system.profileSection = profiler->addSection(label);
+        }
+    }
     
 public:
     /**
@@ -33,9 +45,11 @@ public:
      * @param callback Function to call on tick
      * @param tickInterval How often to tick this system (in seconds)
      * @param priority Lower numbers execute first (default: 0)
+     * @param name Label used for this system in profiler output
      */
-    void registerSystem(TickCallback callback, float tickInterval, int priority = 0) {
-        systems.emplace_back(callback, tickInterval, priority);
+    void registerSystem(TickCallback callback, float tickInterval, int priority = 0, const std::string& name = "") {
+        systems.emplace_back(callback, tickInterval, priority, name);
+        assignProfileSection(systems.back());
         
         // Sort by priority to maintain execution order
         std::sort(systems.begin(), systems.end(), 
@@ -53,6 +67,7 @@ public:
         for (auto& system : systems) {
             if (totalTime - system.lastTickTime >= system.tickInterval) {
                 float actualDelta = totalTime - system.lastTickTime;
+                FrameProfiler::Scope scope(profiler, system.profileSection);
                 system.callback(actualDelta);
                 system.lastTickTime = totalTime;
             }
@@ -69,11 +84,44 @@ public:
         }
     }
     
+    /**
+     * @brief Times every system callback into the given profiler.
+     * @param frameProfiler Profiler owned by the thread calling update(), or nullptr.
+     */
+    void setProfiler(FrameProfiler* frameProfiler) {
+        profiler = frameProfiler;
+        for (auto& system : systems) {
+            assignProfileSection(system);
+        }
+    }
+    
     /**
      * @brief Gets the current total simulation time.
      */
     float getTotalTime() const { return totalTime; }
     
+    /**
+     * @brief Last tick time of each system, in execution order.
+     */
+    std::vector<float> getLastTickTimes() const {
+        std::vector<float> times;
+        times.reserve(systems.size());
+        for (const auto& system : systems) {
+            times.push_back(system.lastTickTime);
+        }
+        return times;
+    }
+    
+    /**
+     * @brief Puts the timers back as getTotalTime() and getLastTickTimes() reported them.
+     */
+    void restoreTimers(float time, const std::vector<float>& lastTickTimes) {
+        totalTime = time;
+        for (size_t i = 0; i < systems.size() && i < lastTickTimes.size(); ++i) {
+            systems[i].lastTickTime = lastTickTimes[i];
+        }
+    }
+    
     /**
      * @brief Resets all system timers.
      */
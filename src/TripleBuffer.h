@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free single-producer/single-consumer triple buffer.
+ *
+ * The producer always has a private back slot to write into, the consumer
+ * always has a private front slot to read from, and the third slot is
+ * handed between them with a single atomic exchange. Neither side ever
+ * waits for the other: the consumer simply sees the most recently
+ * published value, and intermediate values are dropped.
+ *
+ * Slots are reused rather than reallocated, so containers inside T keep
+ * their capacity from one publish to the next.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Slot the producer may freely write to before calling publish().
+     */
+    T& back() { return slots[backIndex]; }
+
+    /**
+     * @brief Hands the back slot to the consumer and takes a fresh one.
+     */
+    void publish() {
+        std::uint8_t previous = middle.exchange(backIndex | FRESH_BIT, std::memory_order_acq_rel);
+        backIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Swaps in the newest published slot if there is one.
+     * @return true if the front slot changed since the last call.
+     */
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+            return false;
+        }
+        std::uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Slot the consumer reads from; stable until the next acquire().
+     */
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH_BIT = 0x4;
+
+    T slots[3];
+    std::uint8_t backIndex = 0;   // Owned by the producer
+    std::uint8_t frontIndex = 1;  // Owned by the consumer
+    std::atomic<std::uint8_t> middle{2};
+};
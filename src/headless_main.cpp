@@ -0,0 +1,235 @@
+#include "Simulation.h"
+#include "BatchRunner.h"
+#include "FrameProfiler.h"
+#include "./ECS/World.h"
+#include "./ECS/components/AIState.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs the town simulation without a window, renderer, font or Gemini key.
+ *
+ * Usage: brenda_headless [--days N] [--time-scale S] [--dt SECONDS]
+ *                        [--environment FILE] [--entities FILE] [--verbose]
+ *                        [--profile CSV] [--load SNAPSHOT] [--save SNAPSHOT]
+ *                        [--spawn N] [--seed S] [--runs N] [--threads T]
+ *
+ * The simulation is stepped in fixed steps of --dt real seconds as fast
+ * as the CPU allows until N simulated days have passed, then ticks per second are reported.
+ * With --profile, per-system timings are printed and written to CSV.
+ * --load resumes from a binary snapshot (clock and time scale included)
+ * instead of the entities file; --save writes one when the run ends.
+ * --spawn adds N citizens from the entities file's "citizen" prefab, spread
+ * over the map, to load-test the simulation; with --load only the file's
+ * prefabs are read. --seed picks the AI's random
+ * stream. With --runs N > 1, N independent simulations with seeds S, S+1,
+ * ... run in parallel on T threads (default: every core) and a per-run
+ * report with min/mean/max is printed instead.
+ */
+int main(int argc, char *argv[])
+{
+    int days = 1;
+    float timeScale = 300.0f;
+    float stepSeconds = 1.0f / 60.0f;
+    std::string environmentFile = "environment.json";
+    std::string entitiesFile = "entities.json";
+    bool verbose = false;
+    std::string profileFile;
+    std::string loadFile;
+    std::string saveFile;
+    int spawnCount = 0;
+    std::uint64_t seed = 1;
+    int runs = 1;
+    int threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        auto hasValue = [&]() { return i + 1 < argc; };
+        if (std::strcmp(argv[i], "--days") == 0 && hasValue()) {
+            days = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--time-scale") == 0 && hasValue()) {
+            timeScale = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--dt") == 0 && hasValue()) {
+            stepSeconds = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--environment") == 0 && hasValue()) {
+            environmentFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--entities") == 0 && hasValue()) {
+            entitiesFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (std::strcmp(argv[i], "--profile") == 0 && hasValue()) {
+            profileFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--load") == 0 && hasValue()) {
+            loadFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--save") == 0 && hasValue()) {
+            saveFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--spawn") == 0 && hasValue()) {
+            spawnCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue()) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--runs") == 0 && hasValue()) {
+            runs = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue()) {
+            threads = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--days N] [--time-scale S] [--dt SECONDS]"
+                      << " [--environment FILE] [--entities FILE] [--verbose] [--profile CSV]"
+                      << " [--load SNAPSHOT] [--save SNAPSHOT] [--spawn N] [--seed S] [--runs N] [--threads T]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (days <= 0 || timeScale <= 0.0f || stepSeconds <= 0.0f) {
+        std::cerr << "--days, --time-scale and --dt must be positive" << std::endl;
+        return 1;
+    }
+    if (spawnCount < 0 || threads < 0 || runs <= 0) {
+        std::cerr << "--spawn and --threads must not be negative, --runs must be positive" << std::endl;
+        return 1;
+    }
+    if (runs > 1 && (!loadFile.empty() || !saveFile.empty() || !profileFile.empty())) {
+        std::cerr << "--load, --save and --profile apply to single runs only" << std::endl;
+        return 1;
+    }
+
+    // --- Batch mode: independent runs with consecutive seeds, one per core ---
+    if (runs > 1) {
+        std::vector<BatchRunSpec> specs(static_cast<size_t>(runs));
+        for (int i = 0; i < runs; ++i) {
+            BatchRunSpec &spec = specs[i];
+            spec.config.timeScale = timeScale;
+            spec.config.seed = seed + static_cast<std::uint64_t>(i);
+            spec.config.stepSeconds = stepSeconds;
+            spec.config.log = nullptr; // Runs interleave; only the report is useful
+            spec.environmentFile = environmentFile;
+            spec.entitiesFile = entitiesFile;
+            spec.days = days;
+            spec.extraCitizens = static_cast<size_t>(spawnCount);
+        }
+
+        BatchRunner runner(static_cast<size_t>(threads));
+
+        // Time the first run on its own, loading included, as the serial baseline
+        auto soloStart = std::chrono::steady_clock::now();
+        bool soloOk = BatchRunner(1).run({specs.front()}).front().ok;
+        double soloSeconds = soloOk ? std::chrono::duration<double>(std::chrono::steady_clock::now() - soloStart).count() : 0.0;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<BatchRunResult> results = runner.run(specs);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Simulated " << runs << " runs of " << days << " day(s) on "
+                  << std::min(runner.getThreadCount(), specs.size()) << " threads\n";
+        BatchRunner::writeReport(std::cout, results, seconds, soloSeconds);
+        bool allOk = std::all_of(results.begin(), results.end(), [](const BatchRunResult &result) { return result.ok; });
+        return allOk ? 0 : 1;
+    }
+
+    // --- Single run ---
+    SimulationConfig config;
+    config.timeScale = timeScale;
+    config.seed = seed;
+    config.stepSeconds = stepSeconds;
+    config.log = verbose ? &std::cout : nullptr; // The AI reports every arrival; quiet unless asked
+    Simulation simulation(config);
+    if (!simulation.loadEnvironment(environmentFile)) {
+        std::cerr << "Failed to load " << environmentFile << std::endl;
+        return 1;
+    }
+
+    FrameProfiler profiler;
+    profiler.setEnabled(!profileFile.empty());
+    simulation.setProfiler(&profiler);
+    const auto sectionTotal = profiler.addSection("total");
+
+    // --- Scene Loading (no shapes: nothing is drawn) ---
+    if (!loadFile.empty()) {
+        if (!simulation.loadSnapshot(loadFile)) {
+            std::cerr << "Failed to load snapshot " << loadFile << std::endl;
+            return 1;
+        }
+        // The snapshot has the entities; --spawn still takes its prefab from the entities file
+        if (spawnCount > 0 && !simulation.loadPrefabs(entitiesFile)) {
+            std::cerr << "Failed to load " << entitiesFile << std::endl;
+            return 1;
+        }
+    } else if (!simulation.loadScene(entitiesFile))
+    {
+        std::cerr << "Failed to load " << entitiesFile << std::endl;
+        return 1;
+    }
+
+    // Extra citizens on an even grid over the whole map
+    double spawnSeconds = 0.0;
+    if (spawnCount > 0) {
+        auto spawnStart = std::chrono::steady_clock::now();
+        bool spawned = simulation.spawnAcrossMap("citizen", static_cast<size_t>(spawnCount));
+        spawnSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - spawnStart).count();
+        if (!spawned) {
+            std::cerr << entitiesFile << " has no \"citizen\" prefab to spawn from" << std::endl;
+            return 1;
+        }
+    }
+
+    // A snapshot already carries homes and AI state
+    if (loadFile.empty()) {
+        simulation.prepareNpcs();
+    }
+
+    // --- Run as fast as possible ---
+    ECS::World &world = simulation.getWorld();
+    Clock &simClock = simulation.getClock();
+    const int lastDay = simClock.getDay() + days;
+
+    auto start = std::chrono::steady_clock::now();
+    while (simClock.getDay() < lastDay) {
+        FrameProfiler::Scope totalScope(&profiler, sectionTotal);
+        simulation.step();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    const SimulationMetrics &metrics = simulation.getMetrics();
+    std::uint64_t ticks = metrics.ticks;
+    std::cout << "Simulated " << days << " day(s) with " << world.getAllComponents<AIState>().size() << " AI entities\n"
+              << "Ticks:            " << ticks << "\n"
+              << "Wall time:        " << seconds << " s\n"
+              << "Ticks per second: " << (seconds > 0.0 ? ticks / seconds : 0.0) << "\n"
+              << "Zones entered:    " << metrics.zonesEntered << "\n"
+              << "Activities ended: " << metrics.activitiesFinished << std::endl;
+    if (spawnCount > 0) {
+        std::cout << "Spawned:          " << spawnCount << " citizens in " << spawnSeconds * 1000.0 << " ms" << std::endl;
+    }
+
+    if (verbose) {
+        ECS::writePoolStats(std::cout, "Component storage", world.getComponentRegistry().getPoolStats());
+    }
+
+    if (!saveFile.empty() && !simulation.saveSnapshot(saveFile)) {
+        std::cerr << "Failed to write snapshot " << saveFile << std::endl;
+        return 1;
+    }
+
+    if (!profileFile.empty()) {
+        // Stats cover the last FrameProfiler::WINDOW samples of each system
+        std::vector<FrameProfiler::Stats> stats;
+        profiler.summarize(stats);
+        FrameProfiler::writeCsv(std::cout, "sim", stats, true);
+
+        std::ofstream csv(profileFile);
+        if (!csv) {
+            std::cerr << "Failed to write " << profileFile << std::endl;
+            return 1;
+        }
+        FrameProfiler::writeCsv(csv, "sim", stats, true);
+    }
+
+    return 0;
+}
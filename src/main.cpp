@@ -4,19 +4,37 @@
 #include "GridRenderer.h"
 #include "Grid.h"
 #include "GeminiClient.h"
-#include "Pathfinder.h"
 #include "AISystem.h"
-#include "./ECS/AIManager.h"
-#include "./ECS/InfoBoxManager.h"
+#include "./ECS/World.h"
+#include "./ECS/MovementManager.h"
+#include "./ECS/components/DescriptionComponent.h"
+#include "./ECS/components/InfoBoxComponent.h"
+#include "./ECS/components/PlayerController.h"
 #include "Clock.h"
-#include "TickManager.h" // Add TickManager include
 #include "TiledParser.h" // Add TiledParser include
+#include "TextRenderer.h"
+#include "InfoBoxRenderer.h"
+#include "Camera.h"
+#include "SpatialHash.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "FrameProfiler.h"
+#include "SimulationCheckpoints.h"
+#include "Simulation.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <iostream>
 #include <format>
 #include <fstream>
+#include <cmath>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "HomeManager.h"  // Add this include
 
@@ -34,41 +52,150 @@ std::string loadApiKey(const std::string& configPath) {
     return configJson.value("gemini_api_key", "");
 }
 
-// Helper function to render clock display
-void renderClock(SDL_Renderer* renderer, TTF_Font* font, const Clock& clock) {
+// Helper function to queue the clock display into the text batch
+void renderClock(TextRenderer& text, const std::string& timeStr) {
     SDL_Color textColor = { 0, 0, 0, 255 };  // Black text
     SDL_Color bgColor = { 255, 255, 255, 200 };  // White background with transparency
     
-    std::string timeStr = clock.getTimeString() + " (" + clock.getTimeOfDay().getPeriodString() + ")";
+    SDL_FPoint size = text.measure(timeStr);
     
-    SDL_Surface* surface = TTF_RenderText_Solid(font, timeStr.c_str(), timeStr.length(), textColor);
-    if (!surface) return;
+    SDL_FRect bgRect;
+    bgRect.w = size.x + 10;
+    bgRect.h = size.y + 6;
+    bgRect.x = 10;
+    bgRect.y = 10;
     
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (texture) {
-        SDL_FRect bgRect;
-        bgRect.w = surface->w + 10;
-        bgRect.h = surface->h + 6;
-        bgRect.x = 10;
-        bgRect.y = 10;
-        
-        SDL_FRect textRect;
-        textRect.w = surface->w;
-        textRect.h = surface->h;
-        textRect.x = bgRect.x + 5;
-        textRect.y = bgRect.y + 3;
-        
-        // Draw background
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, bgColor.r, bgColor.g, bgColor.b, bgColor.a);
-        SDL_RenderFillRect(renderer, &bgRect);
-        
-        // Draw text
-        SDL_RenderTexture(renderer, texture, nullptr, &textRect);
-        SDL_DestroyTexture(texture);
+    // Draw background, then text
+    text.addRect(bgRect, bgColor);
+    text.addText(timeStr, bgRect.x + 5, bgRect.y + 3, textColor);
+}
+
+// Helper function to queue the profiler overlay into the text batch
+void renderProfilerOverlay(TextRenderer& text, const std::vector<FrameProfiler::Stats>& simTimings,
+                           const std::vector<FrameProfiler::Stats>& renderTimings, float screenWidth) {
+    SDL_Color textColor = { 255, 255, 255, 255 };
+    SDL_Color headerColor = { 255, 220, 120, 255 };
+    SDL_Color bgColor = { 0, 0, 0, 180 };
+
+    // The font is proportional, so columns are placed at fixed offsets
+    const float columns[] = { 0.0f, 50.0f, 170.0f, 230.0f, 290.0f };
+    const float width = 350.0f;
+    const float lineHeight = text.getLineHeight();
+    const size_t lineCount = simTimings.size() + renderTimings.size() + 2;
+
+    SDL_FRect bgRect;
+    bgRect.w = width + 10;
+    bgRect.h = lineCount * lineHeight + 6;
+    bgRect.x = screenWidth - bgRect.w - 10;
+    bgRect.y = 10;
+    text.addRect(bgRect, bgColor);
+
+    float x = bgRect.x + 5;
+    float y = bgRect.y + 3;
+    const char* header[] = { "", "section", "min", "mean", "p99 ms" };
+    for (int i = 0; i < 5; ++i) {
+        text.addText(header[i], x + columns[i], y, headerColor);
+    }
+    y += lineHeight;
+
+    char value[16];
+    auto addValue = [&](float ms, float columnX) {
+        std::snprintf(value, sizeof(value), "%.2f", ms);
+        text.addText(value, columnX, y, textColor);
+    };
+    auto addGroup = [&](const char* group, const std::vector<FrameProfiler::Stats>& stats) {
+        for (const auto& s : stats) {
+            text.addText(group, x + columns[0], y, textColor);
+            text.addText(s.name, x + columns[1], y, textColor);
+            addValue(s.minMs, x + columns[2]);
+            addValue(s.meanMs, x + columns[3]);
+            addValue(s.p99Ms, x + columns[4]);
+            y += lineHeight;
+        }
+    };
+    addGroup("sim", simTimings);
+    addGroup("draw", renderTimings);
+
+    text.addText("F3 hide, F4 write frame_profile.csv", x, y, headerColor);
+}
+
+// Copies the info boxes of the given entities into snapshot views
+void collectInfoBoxes(const ECS::World& world, const std::vector<RenderSnapshot::EntityView>& entities,
+                      std::vector<RenderSnapshot::InfoBoxView>& out) {
+    size_t count = 0;
+    for (const auto& entity : entities) {
+        const auto* infoBox = world.getComponent<InfoBoxComponent>(entity.uid);
+        if (!infoBox || infoBox->text.empty()) continue;
+
+        // Reuse existing slots so strings keep their capacity between ticks
+        if (count == out.size()) out.emplace_back();
+        auto& view = out[count++];
+        view.uid = entity.uid;
+        view.x = entity.x;
+        view.y = entity.y;
+        view.text = infoBox->text;
+    }
+    out.resize(count);
+}
+
+/**
+ * @brief Input forwarded from the render thread to the simulation thread.
+ */
+struct SimCommand {
+    enum class Type { Event, CycleTile, SaveGrid, Checkpoint, Rewind, Pick };
+
+    Type type = Type::Event;
+    SDL_Event event{};
+    int gridX = 0;
+    int gridY = 0;
+    float worldX = 0.0f; // Pick position
+    float worldY = 0.0f;
+};
+
+// Maps WASD to a one-cell player step
+bool playerStepFromKey(const SDL_Event& e, int& stepX, int& stepY) {
+    if (e.type != SDL_EVENT_KEY_DOWN) return false;
+
+    switch (e.key.scancode) {
+        case SDL_SCANCODE_W: stepY = -1; return true;
+        case SDL_SCANCODE_S: stepY = 1; return true;
+        case SDL_SCANCODE_A: stepX = -1; return true;
+        case SDL_SCANCODE_D: stepX = 1; return true;
+        default: return false;
+    }
+}
+
+// Applies pause and time speed keys on the simulation thread
+void handleSimulationKey(const SDL_Event& e, Clock& simClock, bool& isPaused) {
+    if (e.type != SDL_EVENT_KEY_DOWN) return;
+
+    if (e.key.scancode == SDL_SCANCODE_P) {
+        isPaused = !isPaused; // Toggle pause state
+        if (isPaused) {
+            std::cout << "--- Game Paused ---\n";
+            simClock.pause();
+        } else {
+            std::cout << "--- Game Resumed ---\n";
+            simClock.resume();
+        }
+    }
+    // Time speed controls
+    if (e.key.scancode == SDL_SCANCODE_1) {
+        simClock.setTimeScale(60.0f);   // Normal speed
+        std::cout << "Time speed: Normal (1x) - Movement scale: 1.0x\n";
+    }
+    if (e.key.scancode == SDL_SCANCODE_2) {
+        simClock.setTimeScale(300.0f);  // 5x speed
+        std::cout << "Time speed: Fast (5x) - Movement scale: 5.0x\n";
+    }
+    if (e.key.scancode == SDL_SCANCODE_3) {
+        simClock.setTimeScale(600.0f);  // 10x speed
+        std::cout << "Time speed: Very Fast (10x) - Movement scale: 10.0x\n";
+    }
+    if (e.key.scancode == SDL_SCANCODE_0) {
+        simClock.setTimeScale(10.0f);   // Slow speed for debugging
+        std::cout << "Time speed: Slow (debug) - Movement scale: 0.17x\n";
     }
-    
-    SDL_DestroySurface(surface);
 }
 
 int main(int argc, char *argv[])
@@ -84,7 +211,10 @@ int main(int argc, char *argv[])
 
     SDL_Init(SDL_INIT_VIDEO);
 
-    SDL_Window *win = SDL_CreateWindow("SDL3 Project", 1280, 960, 0);
+    const int windowWidth = 1280;
+    const int windowHeight = 960;
+
+    SDL_Window *win = SDL_CreateWindow("SDL3 Project", windowWidth, windowHeight, 0);
     if (win == nullptr)
     {
         std::cerr << "SDL_CreateWindow Error: " << SDL_GetError() << std::endl;
@@ -114,22 +244,29 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Build the glyph atlas once; all UI text is batched through it
+    TextRenderer textRenderer(sdl_renderer, font);
+    if (!textRenderer.isValid()) {
+        std::cerr << "TextRenderer Error: could not build glyph atlas" << std::endl;
+        return 1;
+    }
+
     SDL_Event e;
     bool quit = false;
 
-    // --- Manager Declarations ---
-    PositionManager positionManager;
+    // --- World and Managers ---
+    // The simulation owns the world, grid, clock, AI and movement; this
+    // frontend only adds rendering and input on top
+    SimulationConfig simConfig;
+    simConfig.gemini = &gemini; // 1 real second = 300 sim seconds (fast time for testing)
+    Simulation simulation(simConfig);
+    ECS::World& world = simulation.getWorld();
+    HomeManager& homeManager = simulation.getHomeManager();
+    Grid& grid = simulation.getGrid();
+    Clock& simClock = simulation.getClock();
+    SpatialHash& spatialIndex = simulation.getSpatialIndex();
+    Uint32 cellSize = simulation.getCellSize(); // Size of each grid cell in pixels
     RenderableManager renderManager;
-    DescriptionComponentManager descriptionManager;
-    HomeManager homeManager; // This should now work
-    AIManager aiManager; // Add this line
-    MovementManager movementManager; // Add this if not already declared
-    ControllerManager controllerManager; // Add this if not already declared
-    InfoBoxManager infoBoxManager; // Add this if not already declared
-    
-    // --- System Declarations ---
-    Uint32 cellSize = 32; // Size of each grid cell in pixels
-    Grid grid(20, 15);
     
     // Try to load as Tiled map first, then fall back to custom format
     bool mapLoaded = false;
@@ -150,7 +287,7 @@ int main(int argc, char *argv[])
     // Fall back to custom environment format
     if (!mapLoaded) {
         std::cout << "Loading custom environment.json format..." << std::endl;
-        if (!grid.loadFromJson("environment.json")) {
+        if (!simulation.loadEnvironment("environment.json")) {
             std::cerr << "Failed to load environment.json" << std::endl;
             return 1;
         }
@@ -160,55 +297,44 @@ int main(int argc, char *argv[])
     // Dump the grid to console to verify it loaded correctly
     grid.dump();
 
-    Pathfinder pathfinder(grid);
-    Scene scene;
-    Clock simClock(300.0f); 
-    
-    // Create TickManager for coordinated updates
-    TickManager tickManager;
-    
-    // 1 real second = 300 sim seconds (fast time for testing)
-    AISystem aiSystem(&aiManager, &positionManager, &movementManager, 
-                      &descriptionManager, &pathfinder, &grid, &gemini, 
-                      &infoBoxManager, &simClock, &homeManager, // Add homeManager parameter
-                      cellSize);
-    
-    // Register systems with TickManager for coordinated updates
-    // AI system runs at lower frequency for planning
-    tickManager.registerSystem([&aiSystem](float dt) { aiSystem.updateAI(dt); }, 0.5f, 1);
-    
-    // Movement system runs at higher frequency for smooth movement, scaled by time
-    tickManager.registerSystem([&movementManager, &positionManager, &simClock](float dt) { 
-        // Calculate movement time scale: normalize to 1.0 for "normal" speed (60.0f)
-        float timeScale = simClock.getTimeScale() / 60.0f;
-        movementManager.update(positionManager, dt, timeScale);
-    }, 0.016f, 2); // ~60 FPS for smooth movement
-    
-    // Clock always updates at frame rate
-    tickManager.registerSystem([&simClock](float dt) { simClock.update(dt); }, 0.0f, 0);
+    // Each thread times its own work; F3 toggles both, F4 dumps them to CSV
+    FrameProfiler simProfiler;
+    FrameProfiler renderProfiler;
+    simulation.setProfiler(&simProfiler);
+    const auto simSectionSnapshot = simProfiler.addSection("snapshot");
+    const auto simSectionTotal = simProfiler.addSection("total");
+    const auto renderSectionGrid = renderProfiler.addSection("grid");
+    const auto renderSectionEntities = renderProfiler.addSection("entities");
+    const auto renderSectionInfoBoxes = renderProfiler.addSection("infoboxes");
+    const auto renderSectionText = renderProfiler.addSection("text.flush");
+    const auto renderSectionTotal = renderProfiler.addSection("total");
 
     // --- Scene Loading ---
     std::string sceneFile = "entities.json";
-    if (!scene.loadFromFile(sceneFile, &positionManager, &renderManager,
-                            &descriptionManager, &controllerManager,
-                            &movementManager, &aiManager, 
-                            &infoBoxManager, // <-- Pass to Scene
-                            cellSize)) 
+    auto createShape = [&renderManager](ECS::EntityID entity, const ShapeDescription& shape) {
+        SDL_Color color = { shape.r, shape.g, shape.b, shape.a };
+        if (shape.type == "circle") {
+            renderManager.createCircle(entity, shape.x, shape.y, color);
+        }
+    };
+    // Loading also indexes entity positions so renderers only visit what
+    // is on screen; MovementManager keeps the index current from here on
+    if (!simulation.loadScene(sceneFile, createShape)) 
     {
         std::cerr << "Failed to load " << sceneFile << std::endl;
     }
 
+    Camera camera(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
+
     // renderManager.dump();
-    // positionManager.dump();
-    // movementManager.dump();
-    descriptionManager.dump();
-
-    // Assign homes to NPCs
-    int npcCount = 0;
-    for (auto& [entityUID, aiState] : aiManager.states) {
-        homeManager.assignHome(entityUID, "NPC_" + std::to_string(entityUID));
-        npcCount++;
+    std::cout << "--- Description Components ---" << std::endl;
+    for (const auto& [entity, description] : world.getAllComponents<DescriptionComponent>()) {
+        std::cout << "Entity " << entity << ": " << description.name << " - " << description.text << std::endl;
     }
+
+    // Give every NPC a home and start it idle, ready for its first plan
+    std::cout << "Starting initial AI planning..." << std::endl;
+    simulation.prepareNpcs();
     
     // Print home assignments
     std::cout << "\n=== Home Assignments ===" << std::endl;
@@ -218,32 +344,193 @@ int main(int argc, char *argv[])
     }
     std::cout << "========================\n" << std::endl;
     
-    // Force initial AI planning for all NPCs
-    std::cout << "Starting initial AI planning..." << std::endl;
-    for (auto& [entityUID, aiState] : aiManager.states) {
-        aiState.currentState = AIStateName::Idle; // Make sure they start idle
-        auto* movement = movementManager.get(entityUID);
-        if (movement) {
-            movement->phase = MovementPhase::IDLE;
+    // --- Simulation / render split ---
+    // From here on the simulation thread owns the world, the grid and the
+    // clock. The main thread only renders the latest published snapshot and
+    // forwards input back through the command queue, so a slow frame on
+    // either side no longer stalls the other.
+    TripleBuffer<RenderSnapshot> snapshots;
+    SnapshotViewRequest viewRequest;
+    std::mutex commandMutex;
+    std::vector<SimCommand> commandQueue;
+    std::atomic<bool> running{true};
+
+    auto pushCommand = [&](const SimCommand& command) {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        commandQueue.push_back(command);
+    };
+
+    auto requestView = [&](const Camera& cam) {
+        // Pad by the largest overlay drawn around an entity (info boxes)
+        float margin = 32.0f + 200.0f / cam.getZoom();
+        SDL_FRect view = cam.getVisibleWorldRect();
+        viewRequest.set(view.x - margin, view.y - margin, view.w + 2 * margin, view.h + 2 * margin);
+    };
+    requestView(camera);
+
+    std::thread simThread([&]() {
+        // Wake once per fixed step; the simulation catches up if a wake is late
+        const auto tickPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(simulation.getStepSeconds()));
+        auto lastTick = std::chrono::steady_clock::now();
+
+        bool isPaused = false;
+        std::shared_ptr<const Grid> gridView = std::make_shared<const Grid>(grid);
+        // The renderer reads home labels from this copy, never from the live HomeManager
+        auto homeView = std::make_shared<const std::unordered_map<std::string, int>>(homeManager.getHomeResidents());
+        std::vector<SimCommand> pending;
+        std::vector<unsigned int> visible;
+        SimulationCheckpoints checkpoints(8);
+
+        while (running.load(std::memory_order_relaxed)) {
+            auto tickStart = std::chrono::steady_clock::now();
+            float frameSeconds = std::chrono::duration<float>(tickStart - lastTick).count();
+            lastTick = tickStart;
+            bool profiling = simProfiler.isEnabled();
+            std::optional<FrameProfiler::Scope> totalScope;
+            totalScope.emplace(&simProfiler, simSectionTotal);
+
+            // --- Apply input forwarded from the render thread ---
+            {
+                std::lock_guard<std::mutex> lock(commandMutex);
+                pending.swap(commandQueue);
+            }
+            for (const SimCommand& command : pending) {
+                switch (command.type) {
+                    case SimCommand::Type::CycleTile:
+                        grid.cycleTileType(command.gridX, command.gridY);
+                        gridView = std::make_shared<const Grid>(grid);
+                        std::cout << "Clicked tile (" << command.gridX << ", " << command.gridY << ") - cycled to next type" << std::endl;
+                        break;
+
+                    case SimCommand::Type::SaveGrid:
+                        grid.saveToJson("environment.json");
+                        std::cout << "Grid saved to environment.json" << std::endl;
+                        break;
+
+                    case SimCommand::Type::Pick:
+                    {
+                        unsigned int picked = 0;
+                        if (!spatialIndex.findNearest(command.worldX, command.worldY, cellSize * 0.5f, picked)) {
+                            break;
+                        }
+                        const auto* description = world.getComponent<DescriptionComponent>(picked);
+                        const auto* infoBox = world.getComponent<InfoBoxComponent>(picked);
+                        std::cout << "Picked entity " << picked;
+                        if (description) {
+                            std::cout << ": " << description->name << " - " << description->text;
+                        }
+                        if (infoBox && !infoBox->text.empty()) {
+                            std::cout << " (" << infoBox->text << ")";
+                        }
+                        std::cout << std::endl;
+                        break;
+                    }
+
+                    case SimCommand::Type::Checkpoint:
+                        checkpoints.capture(world, grid, homeManager, simClock, simulation.getRunState());
+                        std::cout << "Checkpoint " << checkpoints.size() << "/" << checkpoints.capacity()
+                                  << " taken at " << simClock.getTimeString() << std::endl;
+                        break;
+
+                    case SimCommand::Type::Rewind:
+                    {
+                        SimulationRunState runState;
+                        if (!checkpoints.rewind(0, world, grid, homeManager, simClock, runState)) {
+                            std::cout << "No checkpoint to rewind to" << std::endl;
+                            break;
+                        }
+                        // Rebuild everything derived from the restored state
+                        simulation.setRunState(runState);
+                        simulation.syncDerivedState();
+                        gridView = std::make_shared<const Grid>(grid);
+                        homeView = std::make_shared<const std::unordered_map<std::string, int>>(homeManager.getHomeResidents());
+                        std::cout << "Rewound to " << simClock.getTimeString() << std::endl;
+                        break;
+                    }
+
+                    case SimCommand::Type::Event:
+                    {
+                        handleSimulationKey(command.event, simClock, isPaused);
+                        // Handle player input ALWAYS (not just when unpaused and not in edit mode)
+                        // Player should be able to move even when game is paused or in edit mode
+                        int stepX = 0, stepY = 0;
+                        if (playerStepFromKey(command.event, stepX, stepY)) {
+                            PlayerController::stepPlayers(stepX, stepY, world, grid, cellSize);
+                        }
+                        break;
+                    }
+                }
+            }
+            pending.clear();
+
+            // Clock and AI stand still while paused; movement keeps running
+            // so the player can still walk
+            if (simulation.advance(frameSeconds, isPaused) == 0) {
+                // Woke early: no step came due, so there is nothing new to show
+                totalScope.reset();
+                std::this_thread::sleep_until(tickStart + tickPeriod);
+                continue;
+            }
+
+            // --- Publish a snapshot of what the renderer asked to see ---
+            std::optional<FrameProfiler::Scope> snapshotScope;
+            snapshotScope.emplace(&simProfiler, simSectionSnapshot);
+            RenderSnapshot& snapshot = snapshots.back();
+            snapshot.tick = simulation.getMetrics().ticks;
+            snapshot.paused = isPaused;
+            snapshot.grid = gridView;
+            snapshot.homeResidents = homeView;
+            snapshot.clockText = simClock.getTimeString() + " (" + simClock.getTimeOfDay().getPeriodString() + ")";
+
+            visible.clear();
+            spatialIndex.queryRect(viewRequest.x.load(std::memory_order_relaxed),
+                                   viewRequest.y.load(std::memory_order_relaxed),
+                                   viewRequest.width.load(std::memory_order_relaxed),
+                                   viewRequest.height.load(std::memory_order_relaxed),
+                                   visible);
+
+            snapshot.entities.clear();
+            for (unsigned int uid : visible) {
+                if (auto* pos = world.getComponent<PositionComponent>(uid)) {
+                    snapshot.entities.push_back({uid, pos->x, pos->y});
+                }
+            }
+            collectInfoBoxes(world, snapshot.entities, snapshot.infoBoxes);
+
+            // Close the timers first so this tick's numbers make the snapshot
+            snapshotScope.reset();
+            totalScope.reset();
+            if (profiling) {
+                simProfiler.summarize(snapshot.simTimings);
+            } else {
+                snapshot.simTimings.clear();
+            }
+
+            snapshot.publishedAt = std::chrono::steady_clock::now();
+            snapshots.publish();
+
+            std::this_thread::sleep_until(tickStart + tickPeriod);
         }
-    }
-    
+    });
+
     const int targetFPS = 30;
     const int frameDelay = 1000 / targetFPS;
 
     Uint32 frameStart = 0;
-    Uint32 lastFrameTime = 0;
-    float deltaTime = 0.0f;
 
-    // --- Game Loop Variables ---
-    bool isPaused = false;
+    // --- Render Loop Variables ---
     bool editMode = false; // Add edit mode flag
     bool showZones = true; // Add zone visibility flag (default on)
+    std::vector<FrameProfiler::Stats> renderTimings;
+
+    // Entities and info boxes of the latest snapshot, placed between it and the one before
+    SnapshotInterpolator interpolator;
+    std::vector<RenderSnapshot::EntityView> drawnEntities;
+    std::vector<RenderSnapshot::InfoBoxView> drawnInfoBoxes;
     
     while (!quit) {
         frameStart = SDL_GetTicks();
-        deltaTime = (frameStart - lastFrameTime) / 1000.0f;
-        lastFrameTime = frameStart;
 
         while (SDL_PollEvent(&e))
         {
@@ -251,27 +538,40 @@ int main(int argc, char *argv[])
             {
                 quit = true;
             }
+
+            // Arrow keys / middle-drag pan, mouse wheel zooms, Home resets the view
+            camera.handleEvent(e);
             
             // Handle mouse clicks for tile editing (only in edit mode)
+            // Outside edit mode a left click describes the entity under the cursor
+            if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN && !editMode && e.button.button == SDL_BUTTON_LEFT) {
+                SDL_FPoint world = camera.screenToWorld(e.button.x, e.button.y);
+                SimCommand command;
+                command.type = SimCommand::Type::Pick;
+                command.worldX = world.x;
+                command.worldY = world.y;
+                pushCommand(command);
+            }
+
             if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN && editMode) {
                 if (e.button.button == SDL_BUTTON_LEFT) {
                     // Convert mouse coordinates to grid coordinates
-                    int gridX = e.button.x / cellSize;
-                    int gridY = e.button.y / cellSize;
-                    
-                    // Cycle the tile type
-                    grid.cycleTileType(gridX, gridY);
-                    
-                    std::cout << "Clicked tile (" << gridX << ", " << gridY << ") - cycled to next type" << std::endl;
+                    SDL_FPoint world = camera.screenToWorld(e.button.x, e.button.y);
+                    SimCommand command;
+                    command.type = SimCommand::Type::CycleTile;
+                    command.gridX = static_cast<int>(std::floor(world.x / cellSize));
+                    command.gridY = static_cast<int>(std::floor(world.y / cellSize));
+                    pushCommand(command);
                 }
                 if (e.button.button == SDL_BUTTON_RIGHT) {
                     // Save the current grid state
-                    grid.saveToJson("environment.json");
-                    std::cout << "Grid saved to environment.json" << std::endl;
+                    SimCommand command;
+                    command.type = SimCommand::Type::SaveGrid;
+                    pushCommand(command);
                 }
             }
             
-            // Handle key presses for mode toggles FIRST
+            // Display toggles stay on the render thread
             if (e.type == SDL_EVENT_KEY_DOWN) {
                 if (e.key.scancode == SDL_SCANCODE_E) {
                     editMode = !editMode; // Toggle edit mode
@@ -290,99 +590,94 @@ int main(int argc, char *argv[])
                         std::cout << "--- Zone Visibility Disabled ---\n";
                     }
                 }
-                if (e.key.scancode == SDL_SCANCODE_P) {
-                    isPaused = !isPaused; // Toggle pause state
-                    if (isPaused) {
-                        std::cout << "--- Game Paused ---\n";
-                        simClock.pause();
-                    } else {
-                        std::cout << "--- Game Resumed ---\n";
-                        simClock.resume();
+                if (e.key.scancode == SDL_SCANCODE_F3) {
+                    bool profiling = !renderProfiler.isEnabled();
+                    if (profiling) {
+                        renderProfiler.reset();
                     }
+                    renderProfiler.setEnabled(profiling);
+                    simProfiler.setEnabled(profiling);
                 }
-                // Time speed controls
-                if (e.key.scancode == SDL_SCANCODE_1) {
-                    simClock.setTimeScale(60.0f);   // Normal speed
-                    std::cout << "Time speed: Normal (1x) - Movement scale: 1.0x\n";
-                }
-                if (e.key.scancode == SDL_SCANCODE_2) {
-                    simClock.setTimeScale(300.0f);  // 5x speed
-                    std::cout << "Time speed: Fast (5x) - Movement scale: 5.0x\n";
+                if (e.key.scancode == SDL_SCANCODE_F4 && renderProfiler.isEnabled()) {
+                    std::ofstream csv("frame_profile.csv");
+                    FrameProfiler::writeCsv(csv, "sim", snapshots.front().simTimings, true);
+                    FrameProfiler::writeCsv(csv, "render", renderTimings, false);
+                    std::cout << "Frame profile written to frame_profile.csv" << std::endl;
                 }
-                if (e.key.scancode == SDL_SCANCODE_3) {
-                    simClock.setTimeScale(600.0f);  // 10x speed
-                    std::cout << "Time speed: Very Fast (10x) - Movement scale: 10.0x\n";
+                // F5 keeps an in-memory checkpoint, F9 rewinds to the latest one
+                if (e.key.scancode == SDL_SCANCODE_F5 || e.key.scancode == SDL_SCANCODE_F9) {
+                    SimCommand command;
+                    command.type = e.key.scancode == SDL_SCANCODE_F5 ? SimCommand::Type::Checkpoint
+                                                                     : SimCommand::Type::Rewind;
+                    pushCommand(command);
                 }
-                if (e.key.scancode == SDL_SCANCODE_0) {
-                    simClock.setTimeScale(10.0f);   // Slow speed for debugging
-                    std::cout << "Time speed: Slow (debug) - Movement scale: 0.17x\n";
-                }
-            }
 
-            // Handle player input ALWAYS (not just when unpaused and not in edit mode)
-            // Player should be able to move even when game is paused or in edit mode
-            controllerManager.handleEvents(e, movementManager, positionManager, grid, cellSize);
+                // Pause, time speed and player movement belong to the simulation
+                SimCommand command;
+                command.type = SimCommand::Type::Event;
+                command.event = e;
+                pushCommand(command);
+            }
         }
 
-        // Only update game logic systems if the game is not paused
-        if (!isPaused) {
-            // --- COORDINATED SYSTEM UPDATES ---
-            // Use TickManager for synchronized updates
-            tickManager.update(deltaTime);
-        }
-        
-        // ALWAYS update movement system (even when paused) so player can move
-        // Fix: Use the correct method signature with all required parameters
-        float timeScale = simClock.getTimeScale() / 60.0f; // Normalize time scale
-        movementManager.update(positionManager, deltaTime, timeScale);
-        
-        // Process phase-specific AI logic after movement updates
-        aiSystem.processArrivingEntities();
-        aiSystem.processPlanningEntities();
+        // Tell the simulation which part of the world to include next tick
+        requestView(camera);
+
+        // --- RENDER the latest published snapshot ---
+        snapshots.acquire();
+        const RenderSnapshot& snapshot = snapshots.front();
+        interpolator.interpolate(snapshot, std::chrono::steady_clock::now(), drawnEntities, drawnInfoBoxes);
+
+        std::optional<FrameProfiler::Scope> renderScope;
+        renderScope.emplace(&renderProfiler, renderSectionTotal);
 
-        // --- RENDER (Always run this) ---
         SDL_SetRenderDrawColor(sdl_renderer, 255, 255, 255, 255);
         SDL_RenderClear(sdl_renderer);
-        GridRenderer::renderWithLabels(sdl_renderer, grid, cellSize, font, editMode, showZones, &homeManager); // Pass homeManager
-        renderManager.renderAll(sdl_renderer, positionManager);
+
+        if (snapshot.grid) {
+            {
+                FrameProfiler::Scope scope(&renderProfiler, renderSectionGrid);
+                GridRenderer::renderWithLabels(sdl_renderer, *snapshot.grid, cellSize, camera, &textRenderer, editMode, showZones, snapshot.homeResidents.get());
+            }
+            FrameProfiler::Scope scope(&renderProfiler, renderSectionEntities);
+            renderManager.renderAll(sdl_renderer, drawnEntities, camera);
+        }
         
         // Render edit mode indicator
         if (editMode) {
             SDL_Color editColor = { 255, 0, 0, 255 };  // Red text
-            SDL_Surface* surface = TTF_RenderText_Solid(font, "EDIT MODE - E to toggle, Left click to cycle tiles, Right click to save", 
-                                                       strlen("EDIT MODE - E to toggle, Left click to cycle tiles, Right click to save"), editColor);
-            if (surface) {
-                SDL_Texture* texture = SDL_CreateTextureFromSurface(sdl_renderer, surface);
-                if (texture) {
-                    SDL_FRect textRect = { 10, 60, static_cast<float>(surface->w), static_cast<float>(surface->h) };
-                    SDL_RenderTexture(sdl_renderer, texture, nullptr, &textRect);
-                    SDL_DestroyTexture(texture);
-                }
-                SDL_DestroySurface(surface);
-            }
+            textRenderer.addText("EDIT MODE - E to toggle, Left click to cycle tiles, Right click to save", 10, 60, editColor);
         }
         
         // Render zone visibility indicator
         if (!showZones) {
             SDL_Color zoneColor = { 0, 255, 0, 255 };  // Green text
-            SDL_Surface* surface = TTF_RenderText_Solid(font, "Zones Hidden - Z to toggle", 
-                                                       strlen("Zones Hidden - Z to toggle"), zoneColor);
-            if (surface) {
-                SDL_Texture* texture = SDL_CreateTextureFromSurface(sdl_renderer, surface);
-                if (texture) {
-                    SDL_FRect textRect = { 10, 80, static_cast<float>(surface->w), static_cast<float>(surface->h) };
-                    SDL_RenderTexture(sdl_renderer, texture, nullptr, &textRect);
-                    SDL_DestroyTexture(texture);
-                }
-                SDL_DestroySurface(surface);
-            }
+            textRenderer.addText("Zones Hidden - Z to toggle", 10, 80, zoneColor);
         }
         
         // Render the infoboxes on top
-        infoBoxManager.renderAll(sdl_renderer, font, positionManager);
+        {
+            FrameProfiler::Scope scope(&renderProfiler, renderSectionInfoBoxes);
+            InfoBoxRenderer::render(textRenderer, drawnInfoBoxes, camera);
+        }
         
         // Render the clock display
-        renderClock(sdl_renderer, font, simClock);
+        if (!snapshot.clockText.empty()) {
+            renderClock(textRenderer, snapshot.clockText);
+        }
+
+        // Timing overlay shows the previous frame's render numbers
+        if (renderProfiler.isEnabled()) {
+            renderProfiler.summarize(renderTimings);
+            renderProfilerOverlay(textRenderer, snapshot.simTimings, renderTimings, static_cast<float>(windowWidth));
+        }
+
+        // Submit all overlay text in a single batch
+        {
+            FrameProfiler::Scope scope(&renderProfiler, renderSectionText);
+            textRenderer.flush();
+        }
+        renderScope.reset();
 
         SDL_RenderPresent(sdl_renderer);
 
@@ -393,6 +688,9 @@ int main(int argc, char *argv[])
         }
     }
 
+    running.store(false);
+    simThread.join();
+
     // Cleanup
     TTF_CloseFont(font);
     TTF_Quit();